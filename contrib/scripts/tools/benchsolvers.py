@@ -0,0 +1,90 @@
+"""
+Times Gambit command-line solvers on a set of games.
+
+This is intended for comparing two builds of the command-line tools,
+for example before and after a change to the exact arithmetic
+(Rational) used by the solvers.  Each solver is run on each game
+the given number of times, and the best wall-clock time is reported,
+together with whether the outputs of the builds agree.
+
+Example:
+
+  python benchsolvers.py --bin old/ --bin new/ \\
+     --solver "gambit-simpdiv -q" --solver "gambit-lcp -q -P" \\
+     ../../games/e02.nfg ../../games/poker.efg
+"""
+
+import optparse
+import os
+import subprocess
+import sys
+import time
+
+DEFAULT_SOLVERS = [ "gambit-simpdiv -q", "gambit-lcp -q -P" ]
+
+
+def run(command, game, repeat):
+    """
+    Runs command on game repeat times, returning the best time and
+    the output of the last run.
+    """
+    best = None
+    output = None
+    for i in range(repeat):
+        start = time.time()
+        proc = subprocess.Popen(command + [ game ],
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT)
+        output = proc.communicate()[0]
+        elapsed = time.time() - start
+        if best is None or elapsed < best:
+            best = elapsed
+    return best, output
+
+
+def main():
+    parser = optparse.OptionParser(usage="%prog [options] game...")
+    parser.add_option("--bin", action="append", dest="bins", default=[],
+                      help="directory containing a build of the tools; "
+                      "may be given more than once")
+    parser.add_option("--solver", action="append", dest="solvers",
+                      default=[],
+                      help="solver command line, without the game file")
+    parser.add_option("--repeat", type="int", dest="repeat", default=3,
+                      help="number of runs per measurement (default 3)")
+    options, games = parser.parse_args()
+    if not games:
+        parser.error("no games given")
+    bins = options.bins or [ "" ]
+    solvers = options.solvers or DEFAULT_SOLVERS
+
+    header = "%-24s %-20s" % ("solver", "game")
+    for b in bins:
+        header += " %12s" % (os.path.basename(os.path.normpath(b)) or "PATH")
+    if len(bins) > 1:
+        header += " %8s  %s" % ("speedup", "outputs")
+    print(header)
+
+    for solver in solvers:
+        args = solver.split()
+        for game in games:
+            times = []
+            outputs = []
+            for b in bins:
+                command = [ os.path.join(b, args[0]) ] + args[1:]
+                elapsed, output = run(command, game, options.repeat)
+                times.append(elapsed)
+                outputs.append(output)
+            line = "%-24s %-20s" % (args[0], os.path.basename(game))
+            for elapsed in times:
+                line += " %12.3f" % elapsed
+            if len(bins) > 1:
+                line += " %8.2f  %s" % (times[0] / max(times[-1], 1e-6),
+                                        "same" if outputs[0] == outputs[-1]
+                                        else "DIFFER")
+            print(line)
+            sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -161,6 +161,20 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
 
 
   AggNumber getPurePayoff(int player, int *s);
+
+  //pure strategy Nash equilibria, as k-symmetric configurations: the
+  //number of players of each class choosing each action of the class,
+  //indexed from firstKSymAction(cls). Players of the same class are not
+  //told apart, so for symmetric games this takes time polynomial in the
+  //number of players.
+  void getPureNash(std::vector<std::vector<int> > &dest);
+  //the pure strategy profiles (the index of the action chosen by each
+  //player) with a k-symmetric configuration, in order of player 0's
+  //action varying fastest: the first, and the one following profile.
+  //nextPureProfile() returns false after the last.
+  void firstPureProfile(std::vector<int> &profile, const std::vector<int> &kSymCount);
+  bool nextPureProfile(std::vector<int> &profile);
+
   inline void printPayoffs(std::ostream &s, int node){
     s << payoffs.at(node).size()<<std::endl;
     s << payoffs[node];
@@ -273,6 +287,9 @@ private:
   //foreach s in S, j in N, the index of s in j's action set, or -1 if N/A
   std::vector<std::vector<int> > node2Action;
 
+  //foreach s in S, a player whose action set contains s, or -1 if N/A
+  std::vector<int> node2Player;
+
   //cache of jacobian entries.
   trie_map<AggNumber> cache;
 
@@ -347,6 +364,17 @@ private:
   void doProjection(int Node, int player, AggNumber* s);
 
   void getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
+
+  //payoff of action node Node, given its projected configuration
+  AggNumber getConfigPayoff(int Node, const config &pureconfig);
+  //payoff of action node Node, when count[s] players choose each node s
+  AggNumber getCountPayoff(int Node, const std::vector<int> &count);
+  //whether no player can gain by deviating from the k-symmetric
+  //configuration kSymCount; count is used for the counts of action nodes
+  bool isPureNash(const std::vector<int> &kSymCount, std::vector<int> &count);
+  //assign to players last down to 0 the actions of the nodes left in
+  //their class's pool, choosing each time the action of least index
+  void fillPureProfile(std::vector<int> &profile, int last, std::vector<std::vector<int> > &pool);
 };
 
 }  // end namespace Gambit::agg
@@ -108,6 +108,12 @@ public:
     return r;
   }
 
+  //pure strategy Bayes-Nash equilibria of the agent form, as the index of
+  //the action chosen by each type of each player, with the types of the
+  //first player first.  These are in order of the first type's action
+  //varying fastest.
+  void getPureNash(std::vector<std::vector<int> > &dest);
+
   AggNumber getSymMixedPayoff(StrategyProfile &s);
 
   AggNumber getSymMixedPayoff(int tp, StrategyProfile &s);
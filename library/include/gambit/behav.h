@@ -31,6 +31,12 @@ namespace Gambit {
 /// MixedBehaviorProfile<T> implements a randomized behavior profile on
 /// an extensive game.
 ///
+/// Values computed from the profile (realization probabilities, beliefs,
+/// and node, information set and action values) are cached in the
+/// profile itself, which therefore serves as the context for evaluating
+/// them.  Threads sharing a game should each evaluate their own profiles;
+/// copying a profile does not copy, or read, its cached values.
+///
 template <class T> class MixedBehaviorProfile : public DVector<T>  {
 protected:
   BehaviorSupportProfile m_support;
@@ -123,6 +123,7 @@ public:
 #include "recarray.h"
 #include "vector.h"
 #include "matrix.h"
+#include "threads.h"
 
 #include "rational.h"
 
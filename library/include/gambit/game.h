@@ -39,6 +39,13 @@ namespace Gambit {
 /// but will instead be marked as deleted.  Calling code should always
 /// be careful to check the deleted status of the object before any
 /// operations on it.
+///
+/// When the library is built with GAMBIT_THREADS defined (configure
+/// --enable-threads), the reference count is updated atomically, so
+/// that handles to the objects of one game may be created and released
+/// concurrently by several threads; see GameRep::PrepareForSharing().
+/// This is not the default, as the atomic updates slow down
+/// single-threaded computations on game trees considerably.
 class GameObject {
 protected:
   int m_refCount;
@@ -64,10 +71,18 @@ public:
 
   /// @name Reference counting
   //@{
+#ifdef GAMBIT_THREADS
+  /// Increment the reference count
+  void IncRef(void) { __sync_add_and_fetch(&m_refCount, 1); }
+  /// Decrement the reference count; delete if reference count is zero.
+  void DecRef(void)
+  { if (!__sync_sub_and_fetch(&m_refCount, 1) && !m_valid) delete this; }
+#else
   /// Increment the reference count
   void IncRef(void) { m_refCount++; }
   /// Decrement the reference count; delete if reference count is zero.
   void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+#endif  // GAMBIT_THREADS
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
   //@}
@@ -121,6 +136,10 @@ public:
   operator T *(void) const { return rep; }
 
   bool operator!(void) const { return !rep; }
+
+  /// Exchange the objects referred to by two handles; as each object
+  /// is referred to as often as before, no counts are changed
+  void Swap(GameObjectPtr<T> &r) { T *tmp = rep;  rep = r.rep;  r.rep = tmp; }
 };
 
 //
@@ -236,11 +255,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -343,6 +358,7 @@ class GameStrategyRep : public GameObject  {
   friend class TreePureStrategyProfileRep;
   friend class TablePureStrategyProfileRep;
   friend class StrategySupportProfile;
+  friend class StrategyProfileIterator;
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
   template <class T> friend class MixedBehaviorProfile;
@@ -521,10 +537,14 @@ class PureStrategyProfileRep {
   friend class GameTreeRep;
   friend class GameAggRep;
   friend class PureStrategyProfile;
+  friend class StrategyProfileIterator;
 
 protected:
   Game m_nfg;
   Array<GameStrategy> m_profile;
+  /// The sum of the offsets of the strategies, plus one; for a table
+  /// game, this is the index of the profile in the payoff tables
+  long m_index;
 
   /// Construct a new strategy profile
   PureStrategyProfileRep(const Game &p_game);
@@ -562,7 +582,7 @@ public:
   virtual Rational GetStrategyValue(const GameStrategy &) const = 0;
 
   /// Is the profile a pure strategy Nash equilibrium?
-  bool IsNash(void) const;
+  virtual bool IsNash(void) const;
 
   /// Is the profile a strict pure stategy Nash equilibrium?
   bool IsStrictNash(void) const;
@@ -648,6 +668,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -672,6 +693,12 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Notification that the payoffs of an outcome have been changed
+  virtual void ClearPayoffTables(void) const { }
+  /// Notification that the payoff of an outcome to player pl has been
+  /// changed; by default, the same as ClearPayoffTables()
+  virtual void UpdatePayoffTables(const GameOutcomeRep *, int pl) const
+  { ClearPayoffTables(); }
   //@}
 
 
@@ -682,6 +709,12 @@ public:
   virtual ~GameRep() { }
   /// Create a copy of the game, as a new game
   virtual Game Copy(void) const = 0;
+  /// Build everything the game computes on demand.  Once this has
+  /// been called, and until the game is next modified, the game may be
+  /// read by several threads at once, with each thread using its own
+  /// strategy and behavior profiles, provided the library is built
+  /// with GAMBIT_THREADS defined.
+  virtual void PrepareForSharing(void) { BuildComputedValues(); }
   //@}
 
   /// @name General data access
@@ -805,8 +838,16 @@ typedef GameObjectPtr<GameRep> Game;
 
 /// Factory function to create new game tree
 Game NewTree(void);
-/// Factory function to create new game table
-Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+/// \brief Factory function to create new game table
+///
+/// If p_sparseOutcomes is true, all contingencies are initially
+/// assigned the null outcome; otherwise, each contingency has its own
+/// outcome, which is only allocated when first accessed, so that
+/// creating a large table is cheap.  If p_numeric is true, the game stores
+/// only a floating-point payoff for each player at each contingency,
+/// and has no outcomes; see GameTableRep::IsNumeric().
+Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false,
+	      bool p_numeric = false);
 
 //=======================================================================
 //          Inline members of game representation classes
@@ -816,6 +857,11 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->UpdatePayoffTables(this, pl);
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -839,8 +885,14 @@ template<> inline std::string PureBehaviorProfile::GetPayoff(int pl) const
 //=======================================================================
 
 
-/// Reads a game in .efg or .nfg format from the input stream
-Game ReadGame(std::istream &) throw (InvalidFileException);
+/// \brief Reads a game in .efg or .nfg format from the input stream
+///
+/// If p_numeric is true, a game in .nfg format is read into a numeric
+/// table (see NewTable()); this flag has no effect on other formats.
+/// Games in the binary strategic format (see NfgBinaryGameWriter) are
+/// always read into a numeric table.
+Game ReadGame(std::istream &, bool p_numeric = false)
+  throw (InvalidFileException);
 
 } // end namespace gambit
 
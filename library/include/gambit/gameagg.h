@@ -31,11 +31,16 @@ namespace gametracer {
 class aggame;
 }
 
+namespace Nash {
+class EnumPureStrategySolver;
+}
+
 class GameAggRep : public GameRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class AggMixedStrategyProfileRep;
   friend class AggPureStrategyProfileRep;
   friend class gametracer::aggame;
+  friend class Nash::EnumPureStrategySolver;
 
 private:
   agg::AGG *aggPtr;
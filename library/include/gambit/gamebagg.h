@@ -27,10 +27,15 @@
 
 namespace Gambit {
 
+namespace Nash {
+class EnumPureStrategySolver;
+}
+
 class GameBagentRep : public GameRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class BagentMixedStrategyProfileRep;
   friend class BagentPureStrategyProfileRep;
+  friend class Nash::EnumPureStrategySolver;
 
 private:
   agg::BAGG *baggPtr;
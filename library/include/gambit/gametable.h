@@ -23,10 +23,143 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
 
+/// \brief A payoff table which may be shared by copies of a game
+///
+/// Copying a PayoffTable does not copy the payoffs; instead, the copies
+/// share them until one of the copies is modified, at which point
+/// the modified copy takes a private copy of the payoffs.
+template <class T> class PayoffTable {
+private:
+  struct Rep {
+    int m_refCount;
+    Array<T> m_values;
+
+    Rep(const Array<T> &p_values) : m_refCount(1), m_values(p_values) { }
+  };
+  Rep *m_rep;
+
+#ifdef GAMBIT_THREADS
+  void IncRef(void) { __sync_add_and_fetch(&m_rep->m_refCount, 1); }
+  void DecRef(void) 
+  { if (!__sync_sub_and_fetch(&m_rep->m_refCount, 1)) delete m_rep; }
+#else
+  void IncRef(void) { m_rep->m_refCount++; }
+  void DecRef(void) { if (!--m_rep->m_refCount) delete m_rep; }
+#endif  // GAMBIT_THREADS
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Constructs a table holding a copy of p_values
+  PayoffTable(const Array<T> &p_values = Array<T>())
+    : m_rep(new Rep(p_values)) { }
+  /// Constructs a table sharing the payoffs of p_table
+  PayoffTable(const PayoffTable<T> &p_table) : m_rep(p_table.m_rep)
+  { IncRef(); }
+  ~PayoffTable() { DecRef(); }
+
+  PayoffTable<T> &operator=(const PayoffTable<T> &p_table)
+  { if (m_rep != p_table.m_rep) { 
+      DecRef(); m_rep = p_table.m_rep; IncRef(); 
+    } 
+    return *this; }
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the payoffs, for reading
+  const Array<T> &Values(void) const { return m_rep->m_values; }
+  /// Returns the payoffs, for writing, taking a private copy if shared
+  Array<T> &Modify(void)
+  { if (m_rep->m_refCount > 1) {
+      Rep *rep = new Rep(m_rep->m_values);
+      DecRef();
+      m_rep = rep;
+    }
+    return m_rep->m_values; }
+  //@}
+};
+
+/// \brief The outcome numbers of the contingencies of a table
+///
+/// The numbers are packed into 8, 16 or 32 bits each, as required by
+/// the largest number stored so far; the table is widened as larger
+/// numbers are stored, and may be narrowed again by Pack().  Zero
+/// denotes the null outcome.  Contingencies are numbered from one, as
+/// in Array.
+class OutcomeIndexTable {
+private:
+  long m_length;
+  int m_width;
+  std::vector<unsigned char> m_data;
+
+  /// Repacks the table with entries of p_width bytes
+  void Repack(int p_width);
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Constructs a table of p_length contingencies with the null outcome
+  OutcomeIndexTable(long p_length = 0)
+    : m_length(p_length), m_width(1), m_data(p_length, 0) { }
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the number of contingencies
+  long Length(void) const { return m_length; }
+  /// Returns the number of bytes used for each contingency
+  int Width(void) const { return m_width; }
+  /// Returns the packed entries, of Width() bytes each
+  const unsigned char *Data(void) const
+  { return (m_data.empty()) ? 0 : &m_data[0]; }
+  /// Returns the outcome number of contingency p_index
+  int operator[](long p_index) const
+  {
+    if (p_index < 1 || p_index > m_length)  throw IndexException();
+    switch (m_width) {
+    case 1:
+      return m_data[p_index - 1];
+    case 2:
+      return reinterpret_cast<const unsigned short *>(&m_data[0])[p_index - 1];
+    default:
+      return reinterpret_cast<const unsigned int *>(&m_data[0])[p_index - 1];
+    }
+  }
+  /// Sets the outcome number of contingency p_index, widening if needed
+  void Set(long p_index, int p_outcome)
+  {
+    if (p_index < 1 || p_index > m_length)  throw IndexException();
+    if (m_width < 2 && p_outcome > 0xff)  Repack(2);
+    if (m_width < 4 && p_outcome > 0xffff)  Repack(4);
+    switch (m_width) {
+    case 1:
+      m_data[p_index - 1] = (unsigned char) p_outcome;
+      break;
+    case 2:
+      reinterpret_cast<unsigned short *>(&m_data[0])[p_index - 1] = 
+	(unsigned short) p_outcome;
+      break;
+    default:
+      reinterpret_cast<unsigned int *>(&m_data[0])[p_index - 1] = 
+	(unsigned int) p_outcome;
+      break;
+    }
+  }
+  /// Returns the largest outcome number in the table
+  int Max(void) const;
+  /// \brief Narrows the table to the width required by its entries
+  ///
+  /// Returns the largest outcome number in the table.
+  int Pack(void);
+  //@}
+};
+
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
@@ -35,13 +168,109 @@ class GameTableRep : public GameExplicitRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
-  Array<GameOutcomeRep *> m_results;
+  /// The number of the outcome at each contingency
+  OutcomeIndexTable m_results;
+  /// \brief The number of outcomes which have not yet been created
+  ///
+  /// A new dense table has one outcome per contingency, with outcome i
+  /// at contingency i.  These are only created when first asked for;
+  /// until then, their entries in m_outcomes are null, and they have
+  /// empty labels and the payoffs in m_implicitPayoffs.  While all
+  /// outcomes are implicit, m_outcomes itself is left empty, and
+  /// NumOutcomes() is m_implicitOutcomes.
+  int m_implicitOutcomes;
+  /// \brief Payoffs to each player of the outcomes not yet created
+  ///
+  /// Indexed by outcome number, as m_outcomes; these are set by
+  /// SetPayoff(), and are empty (all payoffs zero) until it is first
+  /// called on an outcome not yet created.
+  Array<Array<Number> > m_implicitPayoffs;
+  /// \brief The largest outcome number at any contingency
+  ///
+  /// This is always an upper bound, and is exact when m_maxOutcomeValid
+  /// is set.  Only the outcomes up to it have entries in the outcome
+  /// payoff tables.
+  mutable int m_maxOutcome;
+  mutable bool m_maxOutcomeValid;
   Game m_unrestricted;
+  /// Are payoffs stored only as floating-point numbers?
+  bool m_numeric;
+
+  /// @name Dense payoff tables
+  //@{
+  /// Payoffs to each player, indexed in the same way as m_results.
+  /// These are shared with copies of the game until either is modified.
+  mutable Array<PayoffTable<double> > m_doublePayoffs;
+  /// Exact payoffs to each player, indexed in the same way as m_results
+  mutable Array<PayoffTable<Rational> > m_rationalPayoffs;
+  /// Are the payoff tables in sync with the outcomes?
+  mutable bool m_doublePayoffsValid, m_rationalPayoffsValid;
+  /// Outcomes whose payoffs have changed since the payoff tables were
+  /// built; their entries are updated when the tables are next read
+  mutable std::vector<int> m_changedOutcomes;
+  //@}
+
+  /// @name Outcome payoff tables
+  //@{
+  /// Payoffs to each player, indexed by outcome number; the entry
+  /// at zero is for the null outcome
+  mutable Array<Array<double> > m_doubleOutcomePayoffs;
+  /// Exact payoffs to each player, indexed by outcome number
+  mutable Array<Array<Rational> > m_rationalOutcomePayoffs;
+  /// Are the outcome payoff tables in sync with the outcomes?
+  mutable bool m_doubleOutcomePayoffsValid, m_rationalOutcomePayoffsValid;
+  //@}
 
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  /// Set the outcome at a contingency, keeping the payoff tables in sync
+  void SetOutcomeIndex(long p_index, GameOutcomeRep *p_outcome);
+  /// Fill the payoff tables from the outcomes
+  template <class T> void BuildPayoffTables(Array<PayoffTable<T> > &) const;
+  /// Fill the outcome payoff tables from the outcomes
+  template <class T> void BuildOutcomePayoffs(Array<Array<T> > &) const;
+  /// Updates the entries of the payoff tables for the changed outcomes
+  void PatchPayoffTables(void) const;
+  /// Returns the payoffs to player pl, indexed by outcome number
+  template <class T> const Array<T> &GetOutcomePayoffs(int pl) const;
+  /// Returns the payoff to player pl of an outcome not yet created
+  template <class T> T GetImplicitPayoff(int p_outcome, int pl) const
+  { return (m_implicitPayoffs.Length() > 0) ?
+      (const T &) m_implicitPayoffs[pl][p_outcome] : T(0); }
+  /// Adds p_weight times the payoffs of the p_length outcomes numbered
+  /// in p_outcomes to p_values
+  template <class I, class T> static void
+  AddOutcomePayoffs(const I *p_outcomes, long p_length, const T *p_payoffs,
+		    const T &p_weight, T *p_values)
+  { for (long i = 0; i < p_length; i++) {
+      p_values[i] += p_weight * p_payoffs[p_outcomes[i]];
+    } }
+  /// Compute the largest outcome number at any contingency, narrowing
+  /// the outcome index as far as it allows
+  void ComputeMaxOutcome(void) const;
+  /// Returns the largest outcome number at any contingency
+  int GetMaxOutcome(void) const
+  { if (!m_maxOutcomeValid) ComputeMaxOutcome();  return m_maxOutcome; }
+  /// Returns the outcome numbered p_outcome, or null if not yet created
+  GameOutcomeRep *GetCreatedOutcome(int p_outcome) const
+  { return (m_outcomes.Length() > 0) ? m_outcomes[p_outcome] : 0; }
+  /// Allocate the (null) entries of m_outcomes, if not yet allocated
+  void AllocateOutcomes(void) const;
+  /// Create the outcome at index p_index, if not yet created
+  GameOutcomeRep *MaterializeOutcome(int p_index) const;
+  //@}
+
+  /// @name Managing the representation
+  //@{
+  virtual void ClearPayoffTables(void) const
+  { m_rationalPayoffsValid = false;  if (!m_numeric) m_doublePayoffsValid = false;
+    m_doubleOutcomePayoffsValid = m_rationalOutcomePayoffsValid = false;
+    m_changedOutcomes.clear();
+    m_maxOutcomeValid = false; }
+  /// Updates the payoff tables in place for the changed payoff
+  virtual void UpdatePayoffTables(const GameOutcomeRep *, int pl) const;
   //@}
 
 public:
@@ -49,14 +278,20 @@ public:
   //@{
   /// Construct a new table game with the given dimension
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
-  GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
+  /// If p_numeric = true, the game stores floating-point payoffs only
+  GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false,
+	       bool p_numeric = false);
+  virtual ~GameTableRep();
   virtual Game Copy(void) const;
+  virtual void PrepareForSharing(void);
   //@}
 
   /// @name General data access
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsConstSum(void) const;
+  virtual Rational GetMinPayoff(int pl = 0) const;
+  virtual Rational GetMaxPayoff(int pl = 0) const;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   //@}
@@ -112,6 +347,15 @@ public:
 
   /// @name Outcomes
   //@{
+  /// Returns the number of outcomes defined in the game
+  virtual int NumOutcomes(void) const
+  { return (m_outcomes.Length() > 0) ? m_outcomes.Length() : m_implicitOutcomes; }
+  /// Returns the index'th outcome defined in the game
+  virtual GameOutcome GetOutcome(int index) const
+  { return MaterializeOutcome(index); }
+  /// Creates a new outcome in the game
+  virtual GameOutcome NewOutcome(void)
+  { AllocateOutcomes();  return GameExplicitRep::NewOutcome(); }
   /// Deletes the specified outcome from the game
   virtual void DeleteOutcome(const GameOutcome &);
   //@}
@@ -122,6 +366,71 @@ public:
   virtual void WriteNfgFile(std::ostream &) const;
   //@}
 
+  /// @name Dense payoff tables
+  //@{
+  /// \brief Returns the payoffs to player pl for every contingency
+  ///
+  /// The table is contiguous, and is indexed by one plus the sum of the
+  /// offsets of the strategies in the contingency (the same index as
+  /// returned by PureStrategyProfileRep::GetIndex()).  Contingencies
+  /// with no outcome have payoff zero.  The table is rebuilt on demand
+  /// after outcomes or their payoffs change.
+  template <class T> const Array<T> &GetPayoffTable(int pl) const;
+  /// \brief Are payoffs evaluated through the outcome numbers?
+  ///
+  /// When the outcomes at the contingencies of a game are few compared
+  /// to its contingencies, payoffs are looked up through the (packed)
+  /// outcome number of each contingency in a small table of payoffs
+  /// per outcome, rather than in the dense payoff tables, which are
+  /// then only built if GetPayoffTable() is called.
+  bool IsOutcomeIndexed(void) const
+  { return !m_numeric && 4L * GetMaxOutcome() <= m_results.Length(); }
+  /// \brief Returns the payoff to player pl at a contingency
+  ///
+  /// The contingency is specified by its index into the payoff tables.
+  /// This is not virtual, and is inlined, for use in loops over
+  /// contingencies; the reference is valid until the game next changes.
+  template <class T> const T &GetPayoff(long p_index, int pl) const;
+  /// \brief Adds the payoffs to player pl at consecutive contingencies
+  ///
+  /// Adds p_weight times the payoff to player pl at each of the p_length
+  /// contingencies starting at index p_index to the corresponding
+  /// entry of p_values.
+  template <class T> void AddPayoffs(long p_index, int pl, long p_length,
+				     const T &p_weight, T *p_values) const;
+  //@}
+
+  /// @name Numeric games
+  //@{
+  /// \brief Does the game store floating-point payoffs only?
+  ///
+  /// A numeric game holds its payoffs only in the floating-point payoff
+  /// tables, and has no outcomes.  Exact payoffs are computed on demand
+  /// as the exact values of the floating-point payoffs.  Operations
+  /// on the outcomes of contingencies throw UndefinedException.
+  bool IsNumeric(void) const { return m_numeric; }
+  /// \brief Sets the payoff to player pl at a contingency
+  ///
+  /// The contingency is specified by its index into the payoff tables.
+  /// Throws UndefinedException if the game is not numeric.
+  void SetPayoff(long p_index, int pl, double p_value);
+  /// \brief Sets the payoff to player pl at a contingency
+  ///
+  /// The contingency is specified by its index into the payoff tables.
+  /// This sets the payoff of the outcome at the contingency; if that
+  /// outcome has not yet been created, the payoff is stored without
+  /// creating it.  Throws UndefinedException if the contingency has the
+  /// null outcome, and ValueException if the text is not a number.
+  void SetPayoff(long p_index, int pl, const std::string &p_value);
+  /// \brief Returns the payoffs to player pl, for setting in bulk
+  ///
+  /// The table is indexed in the same way as GetPayoffTable().  The
+  /// exact payoffs are recomputed from it when next needed, so all
+  /// changes should be made before the game is next used.
+  /// Throws UndefinedException if the game is not numeric.
+  Array<double> &ModifyPayoffTable(int pl);
+  //@}
+
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
   virtual MixedStrategyProfile<double> NewMixedStrategyProfile(double) const;
   virtual MixedStrategyProfile<Rational> NewMixedStrategyProfile(const Rational &) const; 
@@ -130,6 +439,94 @@ public:
 
 };
 
+template<> inline const Array<double> &
+GameTableRep::GetPayoffTable(int pl) const
+{
+  if (!m_changedOutcomes.empty()) {
+    PatchPayoffTables();
+  }
+  if (!m_doublePayoffsValid) {
+    BuildPayoffTables(m_doublePayoffs);
+    m_doublePayoffsValid = true;
+  }
+  return m_doublePayoffs[pl].Values();
+}
+
+template<> inline const Array<Rational> &
+GameTableRep::GetPayoffTable(int pl) const
+{
+  if (!m_changedOutcomes.empty()) {
+    PatchPayoffTables();
+  }
+  if (!m_rationalPayoffsValid) {
+    BuildPayoffTables(m_rationalPayoffs);
+    m_rationalPayoffsValid = true;
+  }
+  return m_rationalPayoffs[pl].Values();
+}
+
+template<> inline const Array<double> &
+GameTableRep::GetOutcomePayoffs(int pl) const
+{
+  if (!m_doubleOutcomePayoffsValid) {
+    BuildOutcomePayoffs(m_doubleOutcomePayoffs);
+    m_doubleOutcomePayoffsValid = true;
+  }
+  return m_doubleOutcomePayoffs[pl];
+}
+
+template<> inline const Array<Rational> &
+GameTableRep::GetOutcomePayoffs(int pl) const
+{
+  if (!m_rationalOutcomePayoffsValid) {
+    BuildOutcomePayoffs(m_rationalOutcomePayoffs);
+    m_rationalOutcomePayoffsValid = true;
+  }
+  return m_rationalOutcomePayoffs[pl];
+}
+
+template <class T> inline const T &
+GameTableRep::GetPayoff(long p_index, int pl) const
+{
+  if (IsOutcomeIndexed()) {
+    return GetOutcomePayoffs<T>(pl)[m_results[p_index]];
+  }
+  return GetPayoffTable<T>(pl)[p_index];
+}
+
+template <class T> void
+GameTableRep::AddPayoffs(long p_index, int pl, long p_length,
+			 const T &p_weight, T *p_values) const
+{
+  if (IsOutcomeIndexed()) {
+    const T *payoffs = &GetOutcomePayoffs<T>(pl)[0];
+    if (p_index < 1 || p_index + p_length - 1 > m_results.Length()) {
+      throw IndexException();
+    }
+    const unsigned char *outcomes = m_results.Data();
+    switch (m_results.Width()) {
+    case 1:
+      AddOutcomePayoffs(outcomes + (p_index - 1), p_length,
+			payoffs, p_weight, p_values);
+      break;
+    case 2:
+      AddOutcomePayoffs(reinterpret_cast<const unsigned short *>(outcomes) +
+			(p_index - 1), p_length, payoffs, p_weight, p_values);
+      break;
+    default:
+      AddOutcomePayoffs(reinterpret_cast<const unsigned int *>(outcomes) +
+			(p_index - 1), p_length, payoffs, p_weight, p_values);
+      break;
+    }
+  }
+  else {
+    const T *payoffs = &GetPayoffTable<T>(pl)[p_index];
+    for (long i = 0; i < p_length; i++) {
+      p_values[i] += p_weight * payoffs[i];
+    }
+  }
+}
+
 }
 
 
@@ -208,6 +208,12 @@ protected:
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  /// Builds a new game from the subtree rooted at the node
+  Game CopySubtree(GameTreeNodeRep *, bool p_allOutcomes) const;
+  /// Copies the subtree rooted at a node into a new game
+  void CopyNode(GameTreeRep *, GameTreeNodeRep *p_src, GameTreeNodeRep *p_dest,
+		Array<GameOutcomeRep *> &, 
+		Array<Array<GameTreeInfosetRep *> > &) const;
   //@}
 
   /// @name Managing the representation
@@ -24,47 +24,69 @@
 #define BFS_H
 
 #include "gambit/gambit.h"
-#include <map>
+#include <vector>
+#include <algorithm>
 
 namespace Gambit  {
 
 namespace linalg  {
-  
+
+//
+// A basic feasible solution, giving the values of the basic variables,
+// which are identified by integer keys.  The keys are held sorted, with
+// the values alongside, and a hash of the set of keys is kept up to date
+// as keys are inserted.
+//
 template <class T> class BFS {
 private:
-  std::map<int, T> m_map;
+  std::vector<int> m_keys;
+  std::vector<T> m_values;
+  unsigned long m_hash;
   T m_default;
 
+  static unsigned long HashKey(int key) {
+    unsigned long x = (unsigned long) key * 2654435761UL;
+    x ^= x >> 13;
+    x *= 1540483477UL;
+    return x ^ (x >> 15);
+  }
+
 public:
   // Lifecycle
-  BFS(void) : m_default(0) { }
+  BFS(void) : m_hash(0), m_default(0) { }
   ~BFS()  { }
 
   // define two BFS's to be equal if their bases are equal
-  bool operator==(const BFS &M) const {
-    if (m_map.size() != M.m_map.size())  return false;
-
-    for (typename std::map<int, T>::const_iterator iter = m_map.begin();
-	 iter != m_map.end(); iter++) {
-      if (M.m_map.count((*iter).first) == 0) {
-	return false;
-      }
-    }
-    return true;
-  }
+  bool operator==(const BFS &M) const
+  { return (m_hash == M.m_hash && m_keys == M.m_keys); }
   bool operator!=(const BFS &M) const  { return !(*this == M); }
 
+  /// Hash of the basis, equal for equal BFS's
+  unsigned long Hash(void) const { return m_hash; }
+
   // Provide map-like operations
-  int count(int key) const { return (m_map.count(key) > 0); }
+  int count(int key) const
+  { return std::binary_search(m_keys.begin(), m_keys.end(), key); }
 
   void insert(int key, const T &value) {
-    m_map.erase(key);
-    m_map.insert(std::pair<int, T>(key, value));
+    std::vector<int>::iterator pos = std::lower_bound(m_keys.begin(),
+						      m_keys.end(), key);
+    size_t i = pos - m_keys.begin();
+    if (pos != m_keys.end() && *pos == key) {
+      m_values[i] = value;
+    }
+    else {
+      m_keys.insert(pos, key);
+      m_values.insert(m_values.begin() + i, value);
+      m_hash += HashKey(key);
+    }
   }
 
   const T &operator[](int key) const {
-    if (m_map.count(key) == 1) {
-      return const_cast<std::map<int, T> &>(m_map)[key];
+    std::vector<int>::const_iterator pos = std::lower_bound(m_keys.begin(),
+							    m_keys.end(), key);
+    if (pos != m_keys.end() && *pos == key) {
+      return m_values[pos - m_keys.begin()];
     }
     else {
       return m_default;
@@ -72,6 +94,53 @@ public:
   }
 };
 
+//
+// A set of BFS's, distinguished by their bases, with membership tested
+// by hashing.
+//
+template <class T> class BFSSet {
+private:
+  std::vector<BFS<T> > m_members;
+  std::vector<std::vector<int> > m_buckets;
+
+  const std::vector<int> &Bucket(const BFS<T> &p_bfs) const
+  { return m_buckets[p_bfs.Hash() % m_buckets.size()]; }
+
+public:
+  BFSSet(void) : m_buckets(16) { }
+
+  int size(void) const { return m_members.size(); }
+
+  bool Contains(const BFS<T> &p_bfs) const {
+    const std::vector<int> &bucket = Bucket(p_bfs);
+    for (size_t i = 0; i < bucket.size(); i++) {
+      if (m_members[bucket[i]] == p_bfs) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  /// Adds the BFS, returning false if it is already a member
+  bool insert(const BFS<T> &p_bfs) {
+    if (Contains(p_bfs)) {
+      return false;
+    }
+    m_members.push_back(p_bfs);
+    if (m_members.size() > 2 * m_buckets.size()) {
+      // Rehash into twice as many buckets
+      m_buckets = std::vector<std::vector<int> >(2 * m_buckets.size());
+      for (size_t i = 0; i < m_members.size(); i++) {
+	m_buckets[m_members[i].Hash() % m_buckets.size()].push_back(i);
+      }
+    }
+    else {
+      m_buckets[p_bfs.Hash() % m_buckets.size()].push_back(m_members.size() - 1);
+    }
+    return true;
+  }
+};
+
 }  // end namespace Gambit::linalg
 
 }  // end namespace Gambit
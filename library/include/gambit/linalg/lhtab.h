@@ -65,16 +65,25 @@ public:
   /// @name Raw Tableau functions
   //@{
   void Refactor(void) { T1.Refactor(); T2.Refactor(); }
+  /// Pivot the variables into the basis, in place of those not among
+  /// them; returns false if they do not form a basis
+  bool PivotToBasis(const Array<int> &p_labels);
   //@}
   
   /// @name Miscellaneous functions
   //@{
   BFS<T> GetBFS(void);
+  /// Returns true if the basis is feasible, and no label has both its
+  /// variables basic at nonzero values
+  bool IsComplementary(void);
 
   int PivotIn(int i);
   int ExitIndex(int i);
   /// Follow a path of ACBFS's from one CBFS to another
   int LemkePath(int dup);
+  /// As LemkePath, but p_abandon(p_data) is asked before each pivot
+  /// whether to give up the path; returns 0 if it was given up
+  int LemkePath(int dup, bool (*p_abandon)(void *), void *p_data);
   //@}
 
 protected:
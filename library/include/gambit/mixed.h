@@ -24,11 +24,14 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
 namespace Gambit {
 
+class GameTableRep;
+
 template <class T> class MixedStrategyProfileRep {
 public:
   Vector<T> m_probs;
@@ -44,14 +47,16 @@ public:
   void Randomize(int p_denom);
  /// Returns the probability the strategy is played
   const T &operator[](const GameStrategy &p_strategy) const
-    { return m_probs[m_support.m_profileIndex[p_strategy->GetId()]]; }
+    { return m_probs[m_support.ProfileIndex(p_strategy->GetId())]; }
   /// Returns the probability the strategy is played
   T &operator[](const GameStrategy &p_strategy)
-    { return m_probs[m_support.m_profileIndex[p_strategy->GetId()]]; }
+    { return m_probs[m_support.ProfileIndex(p_strategy->GetId())]; }
   
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  virtual void GetStrategyValues(Vector<T> &) const = 0;
+  virtual void GetStrategyValueDerivs(Matrix<T> &) const = 0;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -67,11 +72,16 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetStrategyValues(Vector<T> &) const;
+  virtual void GetStrategyValueDerivs(Matrix<T> &) const;
 };
 
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
+  /// The game, which is also held by the support
+  const GameTableRep *m_table;
+
   /// @name Private recursive payoff functions
   //@{
   /// Recursive computation of payoff to player pl
@@ -84,16 +94,41 @@ private:
 		      int cur_pl, long index, const T &prob, T &value) const;
   //@}
 
+  /// @name Private contraction payoff functions
+  //@{
+  /// \brief Computes payoff to player pl by successive contractions
+  ///
+  /// Contracts the payoff table of player pl with the mixed strategy
+  /// of each player in turn, starting from the last player, whose
+  /// strategies are the slowest-varying in the table.  The players of
+  /// the (optional) strategies p_fixed1 and p_fixed2 are not contracted;
+  /// instead, the slice of the table corresponding to that strategy is
+  /// taken.  If p_positiveOnly is true, strategies with negative
+  /// probability are skipped, as is done in the recursive derivatives.
+  T ContractPayoffs(int pl, const GameStrategyRep *p_fixed1,
+		    const GameStrategyRep *p_fixed2, bool p_positiveOnly) const;
+  /// \brief Computes payoffs to player pl for all strategies of one or two players
+  ///
+  /// Contracts the payoff table of player pl with the mixed strategies
+  /// of all players other than p_open1 and p_open2 (which may be zero),
+  /// skipping strategies with nonpositive probability.  On return,
+  /// p_result holds the payoffs for each combination of strategies of the
+  /// open players, indexed with the strategy of the lower-numbered
+  /// open player varying fastest, as in the payoff table itself.
+  void ContractPayoffs(int pl, int p_open1, int p_open2,
+		       std::vector<T> &p_result) const;
+  //@}
+
 public:
-  TableMixedStrategyProfileRep(const StrategySupportProfile &p_support)
-    : MixedStrategyProfileRep<T>(p_support)
-  { }
+  TableMixedStrategyProfileRep(const StrategySupportProfile &p_support);
   virtual ~TableMixedStrategyProfileRep() { }
 
   virtual MixedStrategyProfileRep<T> *Copy(void) const;
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetStrategyValues(Vector<T> &) const;
+  virtual void GetStrategyValueDerivs(Matrix<T> &) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -111,6 +146,8 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetStrategyValues(Vector<T> &) const;
+  virtual void GetStrategyValueDerivs(Matrix<T> &) const;
 };
 
 template <class T> class BagentMixedStrategyProfileRep
@@ -128,6 +165,8 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual void GetStrategyValues(Vector<T> &) const;
+  virtual void GetStrategyValueDerivs(Matrix<T> &) const;
 };
 
 /// \brief A probability distribution over strategies in a game
@@ -253,6 +292,27 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoff to each strategy against the profile
+  ///
+  /// Sets p_values[i] to the payoff to playing the i'th strategy in the
+  /// profile against the profile.  This is equivalent to calling
+  /// GetPayoff(strategy) for each strategy, but computes all the values
+  /// together.  p_values must have length MixedProfileLength().
+  void GetStrategyValues(Vector<T> &p_values) const
+  { m_rep->GetStrategyValues(p_values); }
+
+  /// \brief Computes the derivatives of the payoffs to each strategy
+  ///
+  /// Sets p_derivs(i,j) to the derivative of the payoff to the i'th
+  /// strategy with respect to the probability the j'th strategy is played,
+  /// that is, the second derivative of the payoff to the player of the
+  /// i'th strategy.  Entries for pairs of strategies belonging to the same
+  /// player are zero.  This is equivalent to calling GetPayoffDeriv()
+  /// for each pair of strategies, but computes all the values together.
+  /// p_derivs must be square, with MixedProfileLength() rows.
+  void GetStrategyValueDerivs(Matrix<T> &p_derivs) const
+  { m_rep->GetStrategyValueDerivs(p_derivs); }
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
@@ -93,6 +93,32 @@ private:
   int m_numDecimals;
 };
 
+//
+// Passes profiles computed on a restriction of a game on to another
+// renderer, as profiles on the unrestricted game.  Profiles on a game
+// which is not a restriction are passed on unchanged.
+//
+template <class T>
+class UnrestrictedStrategyRenderer : public MixedStrategyRenderer<T> {
+public:
+  UnrestrictedStrategyRenderer(shared_ptr<StrategyProfileRenderer<T> > p_renderer)
+    : m_renderer(p_renderer) { }
+  virtual ~UnrestrictedStrategyRenderer() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  {
+    if (p_profile.GetGame()->IsRestriction()) {
+      m_renderer->Render(p_profile.Unrestrict(), p_label);
+    }
+    else {
+      m_renderer->Render(p_profile, p_label);
+    }
+  }
+
+private:
+  shared_ptr<StrategyProfileRenderer<T> > m_renderer;
+};
+
 //
 // Encapsulates the rendering of a behavior profile to various text formats.
 //
@@ -205,6 +231,23 @@ private:
 		     List<GameOutcome> &values) const;
 };
 
+//------------------------------------------------------------------------
+//                        Preprocessing of games
+//------------------------------------------------------------------------
+
+/// \brief Eliminates strategies dominated by pure or mixed strategies
+///
+/// Strategies strictly dominated by pure or mixed strategies are
+/// eliminated level by level, until none remain.  Returns the
+/// restriction of the game to the remaining strategies, or the game
+/// itself if no strategy is dominated.  Equilibria of the restriction
+/// are equilibria of the game once mapped back by
+/// MixedStrategyProfile<T>::Unrestrict(), which an
+/// UnrestrictedStrategyRenderer does as it renders them.  The
+/// strategies of each player are checked using up to p_numThreads
+/// threads, if the library is built with thread support.
+Game EliminateDominatedStrategies(const Game &p_game, int p_numThreads = 1);
+
 //
 // Exception raised when maximum number of equilibria to compute
 // has been reached.  A convenience for unraveling a potentially
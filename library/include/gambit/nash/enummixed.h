@@ -63,10 +63,20 @@ private:
 };
 
 
+///
+/// Enumerate the extreme Nash equilibria of a two-player game, as the
+/// complementary pairs of vertices of the two players' best-response
+/// polytopes.  Each vertex is summarized by the set of labels (strategies)
+/// it uses; only pairs of vertices which share no label are tested
+/// for complementarity.  When the library is built with GAMBIT_THREADS
+/// defined, the search for these pairs may be split between several
+/// threads.
+///
 template <class T> class EnumMixedStrategySolver : public StrategySolver<T> {
 public:
-  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
-    : StrategySolver<T>(p_onEquilibrium) {}
+  EnumMixedStrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			  int p_numThreads = 1)
+    : StrategySolver<T>(p_onEquilibrium), m_numThreads(p_numThreads) {}
   virtual ~EnumMixedStrategySolver() { }
 
   shared_ptr<EnumMixedStrategySolution<T> > SolveDetailed(const Game &p_game) const;
@@ -75,8 +85,14 @@ public:
   
   
 private:
+  int m_numThreads;
+
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
+  /// \brief Conservative test for nonzero values, when labelling vertices
+  ///
+  /// The product of two values passing this test never passes EqZero().
+  static bool IsNonzero(const T &x);
 };
 
  
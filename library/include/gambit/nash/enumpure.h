@@ -23,6 +23,7 @@
 #ifndef GAMBIT_NASH_ENUMPURE_H
 #define GAMBIT_NASH_ENUMPURE_H
 
+#include <vector>
 #include "gambit/nash.h"
 
 namespace Gambit {
@@ -31,32 +32,41 @@ namespace Nash {
 ///
 /// Enumerate pure-strategy Nash equilibria of a game.  By definition,
 /// pure-strategy equilibrium uses the strategic representation of a game.
+///
+/// For table games, the best payoff of each player against each profile
+/// of the other players' strategies is computed first; an equilibrium
+/// is then a contingency at which every player attains their best
+/// payoff.  When the library is built with GAMBIT_THREADS defined, both
+/// steps may be split between several threads.
+///
+/// For action-graph games, the search is over configurations (the number
+/// of players of each class choosing each action) rather than over
+/// contingencies; for Bayesian action-graph games, the payoffs of a
+/// player's actions against the others are shared by all of the
+/// player's types.  Equilibria are reported in the order of the
+/// contingencies in any case.
 /// 
 class EnumPureStrategySolver : public StrategySolver<Rational> {
 public:
-   EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0) 
-    : StrategySolver<Rational>(p_onEquilibrium) { }
+  EnumPureStrategySolver(shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			 int p_stopAfter = 0, int p_numThreads = 1) 
+    : StrategySolver<Rational>(p_onEquilibrium),
+      m_stopAfter(p_stopAfter), m_numThreads(p_numThreads) { }
   virtual ~EnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
-};
 
-inline List<MixedStrategyProfile<Rational> >
-EnumPureStrategySolver::Solve(const Game &p_game) const
-{
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  List<MixedStrategyProfile<Rational> > solutions;
-  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
-    if ((*citer)->IsNash()) {
-      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
-  }
-  return solutions;
-}
+private:
+  int m_stopAfter, m_numThreads;
+
+  List<MixedStrategyProfile<Rational> > SolveTable(const Game &p_game) const;
+  List<MixedStrategyProfile<Rational> > SolveAgg(const Game &p_game) const;
+  List<MixedStrategyProfile<Rational> > SolveBagg(const Game &p_game) const;
+  /// Render the pure strategy profile, given by the index of each
+  /// player's strategy from zero, and append it to the solutions
+  void Report(const Game &p_game, const std::vector<int> &p_profile,
+	      List<MixedStrategyProfile<Rational> > &p_solutions) const;
+};
 
 ///
 /// Enumerate pure-strategy agent Nash equilibria of a game.  This uses
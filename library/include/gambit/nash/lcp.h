@@ -34,23 +34,68 @@ template <class T> class LemkeTableau;
 
 namespace Nash {
  
+///
+/// Compute Nash equilibria of a two-player game by following Lemke-Howson
+/// paths.  Unless only one equilibrium is sought, all equilibria
+/// accessible from the extraneous solution are found, by following the
+/// path for each label from each equilibrium in turn.  When the library
+/// is built with GAMBIT_THREADS defined, these paths may be followed by
+/// several threads, each taking up paths left by the others once it
+/// runs out of its own.  Equilibria are reported as they are found, so
+/// their order, and which are found when the number sought or the depth
+/// of the search is limited, may then vary from run to run.
+///
+/// When only one equilibrium is sought, the path is followed from the
+/// first label, unless racing is requested.  Then, when threads are
+/// available, the paths for the labels are followed at once, one in
+/// each of the threads, and the equilibrium at the end of the first
+/// path to finish is returned; the other paths are abandoned.
+///
+/// In exact arithmetic, paths may instead be certified: each is followed
+/// in floating point, and the basis at its end is then checked exactly,
+/// by solving for it in rationals.  Only if it is not a complementary
+/// basic feasible solution is the path followed again exactly.  The
+/// equilibria found are then exact, but in degenerate games may differ
+/// from those found by following every path exactly.
+///
 template <class T> class NashLcpStrategySolver : public StrategySolver<T> {
 public:
   NashLcpStrategySolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			int p_numThreads = 1, bool p_race = false,
+			bool p_certify = false)
     : StrategySolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth),
+      m_numThreads(p_numThreads), m_race(p_race), m_certify(p_certify),
+      m_raceWinner(0) { }
   virtual ~NashLcpStrategySolver()  { }
 
   virtual List<MixedStrategyProfile<T> > Solve(const Game &) const;
 
+  /// @name Path statistics of the last search for a single equilibrium
+  //@{
+  /// Returns the number of exact pivots made along the path for each
+  /// label; paths which were abandoned, or not started, count those made
+  const Array<long> &GetPivotCounts(void) const { return m_pivotCounts; }
+  /// Returns the label whose path gave the equilibrium, or zero if none
+  int GetRaceWinner(void) const { return m_raceWinner; }
+  //@}
+
 private:
-  int m_stopAfter, m_maxDepth;
+  int m_stopAfter, m_maxDepth, m_numThreads;
+  bool m_race, m_certify;
+  mutable Array<long> m_pivotCounts;
+  mutable int m_raceWinner;
 
   class Solution;
+  class Explorer;
+  class Racer;
 
+  int FollowPath(linalg::LHTableau<T> &, int, Solution &,
+		 bool (*)(void *) = 0, void * = 0) const;
   bool OnBFS(const Game &, linalg::LHTableau<T> &, Solution &) const;
   void AllLemke(const Game &, int j, linalg::LHTableau<T> &, Solution &, int) const;
+  void FirstLemke(const Game &, linalg::LHTableau<T> &, Solution &) const;
 };
 
  
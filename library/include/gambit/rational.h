@@ -34,11 +34,43 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 namespace Gambit {
 
 /// A representation of an arbitrary-precision rational number
+///
+/// Values whose numerator and denominator fit in a long are held in
+/// machine integers, so that arithmetic on them needs neither heap
+/// allocation nor multiple-precision operations.  Only values which do
+/// not fit hold their numerator and denominator as Integers, and results
+/// are converted back to machine integers whenever they fit again.  The
+/// representation of each value is therefore unique.
+///
+/// As small values hold no Integer, numerator() and denominator()
+/// return Integers by value, not references to members.
 class Rational {
 protected:
-  Integer num, den;
-
+  /// The numerator and denominator of a value which is not small
+  struct BigRep;
+  /// The numerator and denominator of any value, as Integers
+  class Parts;
+
+  /// @name Representation
+  //@{
+  union {
+    /// The numerator, if the value is small
+    long m_num;
+    /// The numerator and denominator, if the value is not small
+    BigRep *m_big;
+  };
+  /// The (positive) denominator if the value is small; zero otherwise
+  long m_den;
+  //@}
+
+  /// Is the value held in m_num and m_den?
+  bool is_small(void) const { return m_den != 0; }
+  /// Reduces a value held in m_big to lowest terms, and demotes it if small
   void normalize();
+  /// Sets the value to n/d, where d is nonzero and neither is LONG_MIN
+  void set_small(long n, long d);
+  /// Sets the value to n/d, where n and d are not parts of this value
+  void set_big(const Integer &n, const Integer &d);
 
 public:
   Rational(void);
@@ -85,8 +117,8 @@ public:
   friend Rational  sqr(const Rational& x);              // square
   friend Rational  pow(const Rational& x, long y);
   friend Rational  pow(const Rational& x, const Integer& y);
-  const Integer&   numerator() const;
-  const Integer&   denominator() const;
+  Integer          numerator() const;    // returned by value; see above
+  Integer          denominator() const;
 
   // coercion & conversion
 
@@ -118,6 +150,11 @@ public:
 // Naming compatible with Boost's lexical_cast concept for potential future compatibility.
 template<> Rational lexical_cast(const std::string &);
 
+/// Converts the text in [p_begin, p_end) to a Rational, accepting the
+/// same syntax as lexical_cast<Rational>, but without requiring
+/// the text to be copied into a string first.
+Rational ToRational(const char *p_begin, const char *p_end);
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_RATIONAL_H
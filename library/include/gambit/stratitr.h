@@ -32,24 +32,49 @@ namespace Gambit {
 /// on each call of NextContingency().  Optionally, the strategy of
 /// one player may be held fixed during the iteration (by the use of the
 /// second constructor).
+///
+/// By default, contingencies are visited with the first player's
+/// strategy varying fastest, which is the order of the payoff tables
+/// of a table game.  Alternatively, contingencies may be visited in
+/// (reflected, mixed-radix) Gray-code order, in which exactly one
+/// player's strategy changes from one contingency to the next.  This
+/// is cheaper when the order does not matter.
+///
+/// Contingencies are numbered from zero by their position in the
+/// order of iteration.  The iteration may be restricted to a range of
+/// positions with SetRange(); disjoint ranges may then be visited by
+/// separate iterators, for example, in separate threads.
 class StrategyProfileIterator {
   friend class GameRep;
   friend class GameTableRep;
 private:
-  bool m_atEnd;
+  bool m_atEnd, m_grayCode;
   StrategySupportProfile m_support;
-  Array<int> m_currentStrat;
+  /// The strategies of each player in the support, except that the
+  /// handle of each player's current strategy is held by m_profile
+  Array<Array<GameStrategy> > m_strategies;
+  Array<int> m_currentStrat, m_direction;
+  long m_index, m_position, m_end;
   PureStrategyProfile m_profile;
   int m_frozen1, m_frozen2;
   
   /// Reset the iterator to the first contingency (this is called by ctors)
   void First(void);
+  /// \brief Set player pl's strategy to the st'th in the support
+  ///
+  /// The profile is updated directly, without calling its (virtual)
+  /// SetStrategy(); this relies on that only storing the strategy and,
+  /// for a table game, updating the index of the profile.
+  void SetStrategy(int pl, int st);
 
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new iterator on the support, with no strategies held fixed
   StrategyProfileIterator(const StrategySupportProfile &);
+  /// \brief Construct a new iterator on the support, optionally in
+  /// Gray-code order
+  StrategyProfileIterator(const StrategySupportProfile &, bool p_grayCode);
   /// Construct a new iterator on the support, fixing player pl's strategy
   StrategyProfileIterator(const StrategySupportProfile &s, int pl, int st);
   /// Construct a new iterator on the support, fixing the given strategy
@@ -72,9 +97,44 @@ public:
   PureStrategyProfile &operator*(void) { return m_profile; }
   /// Get the current strategy profile
   const PureStrategyProfile &operator*(void) const { return m_profile; }
+
+  /// \brief Get the index of the current contingency
+  ///
+  /// For a table game, this is the index of the contingency in the
+  /// payoff tables, as returned by PureStrategyProfileRep::GetIndex().
+  long GetIndex(void) const { return m_index; }
+  /// Get the position in the support of player pl's current strategy
+  int GetStrategyIndex(int pl) const { return m_currentStrat[pl]; }
+  //@}
+
+  /// @name Ranges of contingencies
+  //@{
+  /// Get the number of contingencies visited over the full range
+  long NumContingencies(void) const;
+  /// \brief Restrict the iteration to a range of positions
+  ///
+  /// The iterator moves to the contingency at position p_begin, and is
+  /// at its end after visiting the one before position p_end.
+  void SetRange(long p_begin, long p_end);
+  /// Get the position of the current contingency
+  long GetPosition(void) const { return m_position; }
   //@}
 };
 
+/// \brief Splits a number of contingencies into balanced ranges
+///
+/// Returns p_chunks + 1 positions, such that the ranges of positions
+/// [bounds[i], bounds[i+1]), for i = 1, ..., p_chunks, cover the
+/// p_count contingencies and differ in size by at most one.  These
+/// are suitable for StrategyProfileIterator::SetRange().  A p_chunks
+/// of less than one is taken as one.
+Array<long> SplitContingencies(long p_count, int p_chunks);
+/// \brief Splits the contingencies of a support into balanced ranges
+///
+/// As above, for the contingencies visited by an iterator on the
+/// support with no strategies held fixed.
+Array<long> SplitContingencies(const StrategySupportProfile &, int p_chunks);
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_STRATITR_H
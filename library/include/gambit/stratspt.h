@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_STRATSPT_H
 #define LIBGAMBIT_STRATSPT_H
 
+#include <vector>
 #include "gambit/gambit.h"
 
 namespace Gambit {
@@ -40,20 +41,60 @@ class StrategySupportProfile;
 ///
 /// Within the support, strategies are maintained in the same order
 /// in which they appear in the underlying game.
+///
+/// Membership is also held as a set of bits, indexed by strategy id,
+/// together with the number of members in the words before each.  The
+/// index of a strategy in a mixed profile on the support is then found
+/// by counting bits, which makes adding and removing strategies cheap,
+/// and supports cheap to compare, order, and hash.
 class StrategySupportProfile {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class MixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
   template <class T> friend class BagentMixedStrategyProfileRep;
+  template <class T> friend class TableMixedStrategyProfileRep;
+  template <class T> friend class TreeMixedStrategyProfileRep;
+  friend class StrategyProfileIterator;
 protected:
   Game m_nfg;
   Array<Array<GameStrategy> > m_support;
 
+  /// The strategies in the support, as bits indexed by (id - 1)
+  std::vector<unsigned long> m_members;
+  /// The number of strategies in the support in the words before each
+  std::vector<int> m_ranks;
+
+  /// Returns the number of bits set in a word
+  static int CountBits(unsigned long p_word)
+  {
+#ifdef __GNUC__
+    return __builtin_popcountl(p_word);
+#else
+    int count = 0;
+    for (; p_word; p_word &= p_word - 1, count++);
+    return count;
+#endif  // __GNUC__
+  }
+  /// Returns the number of strategies in the support with id less than p_id
+  int CountBefore(int p_id) const
+  {
+    int word = (p_id - 1) / c_wordBits;
+    unsigned long mask = 1UL << ((p_id - 1) % c_wordBits);
+    return m_ranks[word] + CountBits(m_members[word] & (mask - 1));
+  }
+  /// Returns true exactly when the strategy with the id is in the support
+  bool ContainsId(int p_id) const
+  {
+    return (m_members[(p_id - 1) / c_wordBits] >>
+	    ((p_id - 1) % c_wordBits)) & 1UL;
+  }
   /// The index into a strategy profile for a strategy (-1 if not in support)
-  Array<int> m_profileIndex;
-  
-  bool Undominated(StrategySupportProfile &newS, int p_player, 
-		   bool p_strict, bool p_external = false) const;
+  int ProfileIndex(int p_id) const
+  { return (ContainsId(p_id)) ? CountBefore(p_id) + 1 : -1; }
+  /// Sets whether the strategy with the id is in the support
+  void SetMember(int p_id, bool p_member);
+
+  static const int c_wordBits = 8 * sizeof(unsigned long);
 
 public:
   /// @name Lifecycle
@@ -66,10 +107,14 @@ public:
   //@{
   /// Test for the equality of two supports (same strategies for all players)
   bool operator==(const StrategySupportProfile &p_support) const
-    { return (m_support == p_support.m_support); }
+    { return (m_nfg == p_support.m_nfg && m_members == p_support.m_members); }
   /// Test for the inequality of two supports
   bool operator!=(const StrategySupportProfile &p_support) const
-    { return (m_support != p_support.m_support); }
+    { return !(*this == p_support); }
+  /// \brief An arbitrary but fixed total order on supports
+  ///
+  /// This allows supports to be used as keys in sorted containers.
+  bool operator<(const StrategySupportProfile &p_support) const;
   //@}
 
   /// @name General information
@@ -98,17 +143,22 @@ public:
   const Array<GameStrategy> &Strategies(const GamePlayer &p_player) const
     { return m_support[p_player->GetNumber()]; }
 
-  /// Returns the index of the strategy in the support.
-  int GetIndex(const GameStrategy &s) const
-    { return m_support[s->GetPlayer()->GetNumber()].Find(s); }
+  /// Returns the index of the strategy in the support (0 if not in support).
+  int GetIndex(const GameStrategy &s) const;
 
   /// Returns true exactly when the strategy is in the support.
   bool Contains(const GameStrategy &s) const
-    { return m_profileIndex[s->GetId()] >= 0; }
+    { return ContainsId(s->GetId()); }
 
   /// Returns true iff this support is a (weak) subset of the specified support
   bool IsSubsetOf(const StrategySupportProfile &) const;
 
+  /// \brief Returns a hash value of the strategies in the support
+  ///
+  /// Equal supports have equal hash values, so that supports may be
+  /// used as keys in hashed containers.
+  size_t Hash(void) const;
+
   //@}
 
   /// @name Writing data files
@@ -132,6 +182,10 @@ public:
 
   /// @name Identification of dominated strategies
   //@{
+  /// \brief Returns true exactly when strategy s dominates strategy t
+  ///
+  /// The strategies are compared on the profiles of the other players'
+  /// strategies in the support.
   bool Dominates(const GameStrategy &s, const GameStrategy &t,
 		 bool p_strict) const;
   bool IsDominated(const GameStrategy &s, bool p_strict, 
@@ -199,6 +253,72 @@ public:
   iterator begin(void) const { return iterator(*this); }
   iterator end(void) const   { return iterator(*this, m_nfg->NumPlayers() + 1); }
 };
+
+class StrategyPayoffSlices;
+
+/// \brief Iterated elimination of dominated strategies
+///
+/// This class eliminates dominated strategies from a support, one level
+/// at a time.  Each player's strategies are compared only on the
+/// profiles of the other players' strategies in the current support.
+/// The payoffs on these profiles are gathered once, and are thinned out
+/// as strategies are eliminated, rather than gathered again at each
+/// level.  A profile which shows that one strategy does not dominate
+/// another remains in the support at later levels, and is tried first
+/// when the two strategies are compared again.
+///
+/// If the library is built with thread support, the comparisons at each
+/// level may be split between several threads.
+class IteratedDominance {
+private:
+  StrategySupportProfile m_support;
+  bool m_strict, m_external, m_mixed;
+  int m_numThreads;
+  Array<StrategyPayoffSlices *> m_slices;
+
+  /// @name Private copy constructor and assignment
+  //@{
+  IteratedDominance(const IteratedDominance &);
+  IteratedDominance &operator=(const IteratedDominance &);
+  //@}
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// \brief Begins an elimination from the support
+  ///
+  /// If p_external is true, a strategy is also eliminated if it is
+  /// dominated by a strategy of the player which is not in the support.
+  IteratedDominance(const StrategySupportProfile &, bool p_strict,
+		    bool p_external = false, int p_numThreads = 1);
+  ~IteratedDominance();
+  //@}
+
+  /// @name Elimination
+  //@{
+  /// \brief Sets whether strategies dominated by mixed strategies are
+  /// also eliminated
+  ///
+  /// Dominance by mixed strategies is always strict, whether or not
+  /// dominance by pure strategies is; it is decided by solving a linear
+  /// program for each strategy which no pure strategy dominates.
+  void SetMixed(bool p_mixed) { m_mixed = p_mixed; }
+  /// Returns true if strategies dominated by mixed strategies are eliminated
+  bool IsMixed(void) const { return m_mixed; }
+  /// Returns the support remaining after the levels eliminated so far
+  const StrategySupportProfile &GetSupport(void) const { return m_support; }
+  /// \brief Eliminates one level of dominated strategies
+  ///
+  /// The strategies of all players which are dominated in the current
+  /// support are eliminated together.  Returns true if any strategy
+  /// was eliminated.
+  bool NextLevel(void);
+  /// As above, eliminating only the strategies of the given players
+  bool NextLevel(const Array<int> &p_players);
+  /// Eliminates levels of dominated strategies until none remain
+  void EliminateAll(void) { while (NextLevel()); }
+  //@}
+};
   
 } // end namespace Gambit
 
@@ -0,0 +1,49 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/threads.h
+// Running parts of a computation in separate threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_THREADS_H
+#define LIBGAMBIT_THREADS_H
+
+#include "array.h"
+
+namespace Gambit {
+
+/// \brief A part of a computation, such as one range of contingencies,
+/// which may be run in its own thread
+class ParallelTask {
+public:
+  virtual ~ParallelTask() { }
+  /// Carries out the task
+  virtual void Run(void) = 0;
+};
+
+/// \brief Runs the tasks, returning once all have finished
+///
+/// When the library is built with GAMBIT_THREADS defined, each task
+/// after the first is run in its own thread, and the first in the
+/// calling thread.  A task for which a thread cannot be started is run
+/// in the calling thread.  Otherwise, the tasks are run in turn.
+void RunParallelTasks(const Array<ParallelTask *> &p_tasks);
+
+} // end namespace Gambit
+
+#endif // LIBGAMBIT_THREADS_H
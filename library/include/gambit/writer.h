@@ -74,6 +74,37 @@ public:
   std::string Write(const Game &p_game, int p_rowPlayer, int p_colPlayer) const;
 };
 
+///
+/// Format the strategic representation of a game in Gambit's binary
+/// strategic game format, which ReadGame() reads into a numeric table
+/// (see GameTableRep::IsNumeric()).
+///
+/// The format consists of the eight bytes of Magic, followed by the
+/// format version, the number of players, and the number of strategies
+/// of each player, each as a four-byte unsigned integer.  Next come the
+/// title, the comment, the player labels and the strategy labels, each
+/// as a four-byte length followed by the characters.  Last come the
+/// payoff tables of the players in turn, each holding a double for
+/// every contingency, indexed as in GameTableRep::GetPayoffTable().
+/// All integers and doubles are stored little-endian.
+///
+/// Payoffs of games other than numeric tables are exact, so these are
+/// written only if every payoff is exactly a double; otherwise, Write()
+/// throws an UndefinedException.
+///
+class NfgBinaryGameWriter : public GameWriter {
+public:
+  /// The bytes which start a file in the binary format
+  static const char Magic[8];
+  /// The version of the format written
+  static const unsigned int Version = 1;
+
+  ///
+  /// Convert the game to the binary strategic game format
+  ///
+  virtual std::string Write(const Game &p_game) const;
+};
+
 } // end namespace Gambit
 
 #endif // LIBGAMBIT_WRITER_H
@@ -62,6 +62,7 @@ Porder(Po),
 Pr(P),
 isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
+node2Player(numANodes,-1),
 cache(numPlayers+1),
 player2Class(numPlayers),
 kSymStrategyOffset(1,0)
@@ -130,8 +131,10 @@ kSymStrategyOffset(1,0)
     for(int j=0;j<numPlayers;j++)
 	node2Action[i][j]=-1;
   for(int i=0;i<numPlayers;i++)
-    for(int j=0;j<actions[i];j++)
+    for(int j=0;j<actions[i];j++){
 	node2Action[actionSets[i][j]][i]=j;
+	node2Player[actionSets[i][j]]=i;
+    }
 
 }
 
@@ -638,12 +641,16 @@ AggNumber AGG::getPurePayoff(int player, int *s){
         (*projFunctions[Node][j]) (pureprofile[j],projection[Node][i][s[i]][j] );
     }
   }
-  aggpayoff::iterator p= payoffs[Node].find(pureprofile);
+  return getConfigPayoff(Node, pureprofile);
+}
+
+AggNumber AGG::getConfigPayoff(int Node, const config &pureconfig){
+  aggpayoff::iterator p= payoffs[Node].find(pureconfig);
   if ( p == payoffs[Node].end() ){
     cout<<"AGG::getPurePayoff ERROR: unable to find the following configuration"
         <<endl;
     cout <<"[";
-    copy(pureprofile.begin(),pureprofile.end(),ostream_iterator<int>(cout, " "));
+    copy(pureconfig.begin(),pureconfig.end(),ostream_iterator<int>(cout, " "));
     cout<<"]" <<endl;
     cout<< "\tin payoffs of action node #"<<Node<<endl;
     exit(1);
@@ -651,6 +658,141 @@ AggNumber AGG::getPurePayoff(int player, int *s){
   return p->second;
 }
 
+AggNumber AGG::getCountPayoff(int Node, const vector<int> &count){
+  //apply the contribution of each player's action node, as in getPurePayoff()
+  int keylen = neighbors[Node].size();
+  config pureconfig;
+  for (int s=0; s<numActionNodes; s++){
+    if (count[s]==0) continue;
+    const config &contrib = projection[Node][node2Player[s]][node2Action[s][node2Player[s]]];
+    int k=0;
+    if (pureconfig.empty()){
+      pureconfig=contrib;
+      k=1;
+    }
+    for (; k<count[s]; k++){
+      for (int j=0; j<keylen; j++){
+        pureconfig[j]= (*projFunctions[Node][j]) (pureconfig[j],contrib[j]);
+      }
+    }
+  }
+  return getConfigPayoff(Node, pureconfig);
+}
+
+//advance x, of length m, to the next composition of the same sum, taking
+//them in reverse lexicographic order.  After the last, wraps around to the
+//first and returns false.
+static bool nextComposition(int *x, int m){
+  int t=x[m-1];
+  x[m-1]=0;
+  int i=m-2;
+  while (i>=0 && x[i]==0) --i;
+  if (i<0){
+    x[0]=t;
+    return false;
+  }
+  x[i]--;
+  x[i+1]=t+1;
+  return true;
+}
+
+bool AGG::isPureNash(const vector<int> &kSymCount, vector<int> &count){
+  fill(count.begin(),count.end(),0);
+  for (size_t cls=0; cls<playerClasses.size(); ++cls){
+    for (size_t k=0; k<uniqueActionSets[cls].size(); ++k){
+      count[uniqueActionSets[cls][k]] += kSymCount[kSymStrategyOffset[cls]+k];
+    }
+  }
+  //players of a class choosing the same action node have the same
+  //deviations, so these are checked once for all of them
+  for (size_t cls=0; cls<playerClasses.size(); ++cls){
+    const ActionSet &as=uniqueActionSets[cls];
+    for (size_t k=0; k<as.size(); ++k)if (kSymCount[kSymStrategyOffset[cls]+k]>0){
+      AggNumber current=getCountPayoff(as[k],count);
+      bool better=false;
+      count[as[k]]--;
+      for (size_t k2=0; !better && k2<as.size(); ++k2)if (k2!=k){
+        count[as[k2]]++;
+        better=(getCountPayoff(as[k2],count) > current);
+        count[as[k2]]--;
+      }
+      count[as[k]]++;
+      if (better) return false;
+    }
+  }
+  return true;
+}
+
+void AGG::fillPureProfile(vector<int> &profile, int last, vector<vector<int> > &pool){
+  for (int i=last; i>=0; --i){
+    vector<int> &nodes=pool[player2Class[i]];
+    size_t best=0;
+    for (size_t k=1; k<nodes.size(); ++k){
+      if (node2Action[nodes[k]][i] < node2Action[nodes[best]][i]) best=k;
+    }
+    profile[i]=node2Action[nodes[best]][i];
+    nodes.erase(nodes.begin()+best);
+  }
+}
+
+void AGG::firstPureProfile(vector<int> &profile, const vector<int> &kSymCount){
+  vector<vector<int> > pool(playerClasses.size());
+  for (size_t cls=0; cls<playerClasses.size(); ++cls){
+    for (size_t k=0; k<uniqueActionSets[cls].size(); ++k){
+      pool[cls].insert(pool[cls].end(), kSymCount[kSymStrategyOffset[cls]+k],
+                       uniqueActionSets[cls][k]);
+    }
+  }
+  profile.resize(numPlayers);
+  fillPureProfile(profile, numPlayers-1, pool);
+}
+
+bool AGG::nextPureProfile(vector<int> &profile){
+  //find the first player whose action can be increased, by exchanging
+  //action nodes with a player before it of the same class
+  for (int i=1; i<numPlayers; ++i){
+    int cls=player2Class[i];
+    int best=-1, bestj=-1;
+    for (int j=0; j<i; ++j)if (player2Class[j]==cls){
+      int act=node2Action[actionSets[j][profile[j]]][i];
+      if (act>profile[i] && (best<0 || act<best)){
+        best=act;
+        bestj=j;
+      }
+    }
+    if (best<0) continue;
+
+    //the players before i then take the remaining nodes in least order
+    vector<vector<int> > pool(playerClasses.size());
+    for (int j=0; j<i; ++j)if (j!=bestj){
+      pool[player2Class[j]].push_back(actionSets[j][profile[j]]);
+    }
+    pool[cls].push_back(actionSets[i][profile[i]]);
+    profile[i]=best;
+    fillPureProfile(profile, i-1, pool);
+    return true;
+  }
+  return false;
+}
+
+void AGG::getPureNash(vector<vector<int> > &dest){
+  //kSymCount[firstKSymAction(cls)+k]: the number of players of class cls
+  //choosing the k'th action of the class
+  vector<int> kSymCount(numKSymActions,0);
+  for (size_t cls=0; cls<playerClasses.size(); ++cls){
+    kSymCount[kSymStrategyOffset[cls]]=playerClasses[cls].size();
+  }
+  vector<int> count(numActionNodes);
+  size_t cls;
+  do {
+    if (isPureNash(kSymCount,count)){
+      dest.push_back(kSymCount);
+    }
+    for (cls=0; cls<playerClasses.size() &&
+           !nextComposition(&kSymCount[kSymStrategyOffset[cls]],uniqueActionSets[cls].size()); ++cls);
+  } while (cls<playerClasses.size());
+}
+
 AggNumber AGG::getMixedPayoff(int player, StrategyProfile &s){
   AggNumber result=0.0;
   assert(player>=0 && player < numPlayers);
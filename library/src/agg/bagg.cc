@@ -280,6 +280,61 @@ AggNumber BAGG::getPurePayoff(int player, int tp, int *ps)
   return getMixedPayoff(player,tp,st);
 }
 
+void BAGG::getPureNash(vector<vector<int> > &dest)
+{
+  int numAgents=typeOffset[numPlayers];
+  vector<int> ps(numAgents,0);
+  StrategyProfile as(aggPtr->getNumActions());
+  //the payoff of each of a player's actions in the AGG, given the others'
+  //strategies; these are shared by all of the player's types, so each is
+  //computed once, when first needed
+  AggNumberVector value(aggPtr->getMaxActions());
+  vector<bool> known(aggPtr->getMaxActions());
+
+  while (true) {
+    bool isNash=true;
+    for (int pl=0; isNash && pl<numPlayers; ++pl){
+      //the others' strategies induce a mixed strategy in the AGG,
+      //as in getAGGStrat()
+      for (int i=0;i<aggPtr->getNumActions();++i) as[i]=AggNumber(0.0);
+      for (int pl2=0; pl2<numPlayers; ++pl2)if (pl2!=pl){
+	for (int t=0;t<numTypes[pl2];++t){
+	  int aact=typeAction2ActionIndex[pl2][t][ps[typeOffset[pl2]+t]];
+	  as[aact+aggPtr->firstAction(pl2)] += indepTypeDist[pl2][t];
+	}
+      }
+      fill(known.begin(),known.end(),false);
+
+      for (int tp=0; isNash && tp<numTypes[pl]; ++tp){
+	int cur=typeAction2ActionIndex[pl][tp][ps[typeOffset[pl]+tp]];
+	for (size_t act=0; isNash && act<typeActionSets[pl][tp].size(); ++act){
+	  int aact=typeAction2ActionIndex[pl][tp][act];
+	  if (!known[cur]){
+	    value[cur]=aggPtr->getV(pl,cur,as);
+	    known[cur]=true;
+	  }
+	  if (!known[aact]){
+	    value[aact]=aggPtr->getV(pl,aact,as);
+	    known[aact]=true;
+	  }
+	  isNash=(value[aact] <= value[cur]);
+	}
+      }
+    }
+    if (isNash) dest.push_back(ps);
+
+    int agent=0;
+    for (int pl=0; pl<numPlayers; ++pl){
+      for (int tp=0; tp<numTypes[pl]; ++tp, ++agent){
+	if (++ps[agent] < (int) typeActionSets[pl][tp].size()) break;
+	ps[agent]=0;
+      }
+      if (agent < typeOffset[pl+1]) break;
+    }
+    if (agent==numAgents) return;
+  }
+}
+
 void BAGG::getSymAGGStrat(StrategyProfile &as, const StrategyProfile &s)
 {
   for (int i=0;i<aggPtr->getNumActionNodes();++i) as[i]=AggNumber(0.0);
@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
+
 #include "gambit/gambit.h"
 #include "gambit/linalg/vertenum.imp"
 #include "gambit/nash/enummixed.h"
@@ -70,6 +72,61 @@ EnumMixedStrategySolution<T>::GetCliques(void) const
   return solution;
 }
 
+namespace {
+
+typedef unsigned long LabelWord;
+const int c_wordBits = 8 * sizeof(LabelWord);
+
+//
+// Finds, for each vertex of one polytope in a range, the vertices of the
+// other polytope which might complete it to an equilibrium.  A vertex of
+// the second polytope is a candidate if it uses none of the labels
+// used by the vertex of the first; for each label, the vertices of the
+// second polytope using it are held as a bitset.
+//
+class VertexMatchTask : public ParallelTask {
+private:
+  const std::vector<std::vector<int> > &m_labels;
+  const std::vector<std::vector<LabelWord> > &m_usedBy;
+  const std::vector<LabelWord> &m_vertices;
+  int m_begin, m_end;
+  std::vector<std::vector<int> > &m_candidates;
+
+public:
+  VertexMatchTask(const std::vector<std::vector<int> > &p_labels,
+		  const std::vector<std::vector<LabelWord> > &p_usedBy,
+		  const std::vector<LabelWord> &p_vertices,
+		  int p_begin, int p_end,
+		  std::vector<std::vector<int> > &p_candidates)
+    : m_labels(p_labels), m_usedBy(p_usedBy), m_vertices(p_vertices),
+      m_begin(p_begin), m_end(p_end), m_candidates(p_candidates) { }
+  virtual ~VertexMatchTask() { }
+
+  virtual void Run(void)
+  {
+    std::vector<LabelWord> unused(m_vertices.size());
+    for (int v = m_begin; v < m_end; v++) {
+      unused = m_vertices;
+      const std::vector<int> &labels = m_labels[v];
+      for (size_t k = 0; k < labels.size(); k++) {
+	const std::vector<LabelWord> &usedBy = m_usedBy[labels[k]];
+	for (size_t w = 0; w < unused.size(); w++) {
+	  unused[w] &= ~usedBy[w];
+	}
+      }
+      for (size_t w = 0; w < unused.size(); w++) {
+	for (LabelWord bits = unused[w]; bits != 0; bits &= bits - 1) {
+	  int bit = 0;
+	  while (!((bits >> bit) & 1UL))  bit++;
+	  m_candidates[v].push_back(w * c_wordBits + bit);
+	}
+      }
+    }
+  }
+};
+
+}  // end anonymous namespace
+
 template <class T> shared_ptr<EnumMixedStrategySolution<T> >
 EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
 {
@@ -131,25 +188,85 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
+  int n1 = p_game->Players()[1]->Strategies().size();
+  int n2 = p_game->Players()[2]->Strategies().size();
+
+  // Label the strategies of player 1 from 0 and those of player 2 after
+  // them.  A vertex of the second polytope uses the labels of player 1's
+  // strategies in its support and of player 2's strategies which are not
+  // best responses to it; a vertex of the first polytope, conversely.
+  // A pair of vertices is an equilibrium only if no label is used by
+  // both, so only such pairs need the full test of complementarity.
+  std::vector<std::vector<int> > labels2(solution->m_v2);
+  for (int i2 = 2; i2 <= solution->m_v2; i2++) {
+    const BFS<T> &bfs1 = verts2[i2];
+    for (int k = 1; k <= n1; k++) {
+      if (bfs1.count(k) && IsNonzero(bfs1[k])) {
+	labels2[i2 - 1].push_back(k - 1);
+      }
+    }
+    for (int k = 1; k <= n2; k++) {
+      if (bfs1.count(-k) && IsNonzero(bfs1[-k])) {
+	labels2[i2 - 1].push_back(n1 + k - 1);
+      }
+    }
+  }
+
+  int numWords = (solution->m_v1 + c_wordBits - 1) / c_wordBits;
+  std::vector<std::vector<LabelWord> > usedBy1(n1 + n2,
+					       std::vector<LabelWord>(numWords, 0));
+  std::vector<LabelWord> vertices1(numWords, 0);
+  for (int i1 = 2; i1 <= solution->m_v1; i1++) {
+    const BFS<T> &bfs2 = verts1[i1];
+    int word = (i1 - 1) / c_wordBits;
+    LabelWord bit = 1UL << ((i1 - 1) % c_wordBits);
+    vertices1[word] |= bit;
+    for (int k = 1; k <= n1; k++) {
+      if (bfs2.count(-k) && IsNonzero(bfs2[-k])) {
+	usedBy1[k - 1][word] |= bit;
+      }
+    }
+    for (int k = 1; k <= n2; k++) {
+      if (bfs2.count(k) && IsNonzero(bfs2[k])) {
+	usedBy1[n1 + k - 1][word] |= bit;
+      }
+    }
+  }
+
+#ifdef GAMBIT_THREADS
+  int numTasks = std::max(1, std::min(m_numThreads, solution->m_v2));
+#else
+  int numTasks = 1;
+#endif  // GAMBIT_THREADS
+  std::vector<std::vector<int> > candidates(solution->m_v2);
+  Array<ParallelTask *> tasks(numTasks);
+  for (int j = 1; j <= numTasks; j++) {
+    tasks[j] = new VertexMatchTask(labels2, usedBy1, vertices1,
+				   1 + (long) (solution->m_v2 - 1) * (j - 1) / numTasks,
+				   1 + (long) (solution->m_v2 - 1) * j / numTasks,
+				   candidates);
+  }
+  RunParallelTasks(tasks);
+  for (int j = 1; j <= numTasks; delete tasks[j++]);
+
   int id1 = 0, id2 = 0;
 
   for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
-    for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
+    const BFS<T> &bfs1 = verts2[i2];
+    for (size_t c = 0; c < candidates[i2 - 1].size(); c++) {
+      int i1 = candidates[i2 - 1][c] + 1;
+      const BFS<T> &bfs2 = verts1[i1];
 	
       // check if solution is nash 
       // need only check complementarity, since it is feasible
       bool nash = true;
-      for (int k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
+      for (int k = 1; nash && k <= n1; k++) {
 	if (bfs1.count(k) && bfs2.count(-k)) {
 	  nash = nash && EqZero(bfs1[k] * bfs2[-k]);
 	}
       }
 
-      for (int k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
+      for (int k = 1; nash && k <= n2; k++) {
 	if (bfs2.count(k) && bfs1.count(-k)) {
 	  nash = nash && EqZero(bfs2[k] * bfs1[-k]);
 	}
@@ -205,6 +322,18 @@ template<> bool EnumMixedStrategySolver<Rational>::EqZero(const Rational &x)
   return (x == Rational(0));
 }
 
+template<> bool EnumMixedStrategySolver<double>::IsNonzero(const double &x)
+{
+  // The product of two numbers which pass is never EqZero()
+  double eps = ::pow(10.0, -7.0);
+  return (x > eps || x < -eps);
+}
+
+template<> bool EnumMixedStrategySolver<Rational>::IsNonzero(const Rational &x)
+{
+  return (x != Rational(0));
+}
+
 
 template class EnumMixedStrategySolver<double>;
 template class EnumMixedStrategySolver<Rational>;  
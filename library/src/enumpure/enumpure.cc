@@ -0,0 +1,362 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/enumpure/enumpure.cc
+// Enumerate pure-strategy equilibrium profiles of strategic games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include <algorithm>
+#include <queue>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/gameagg.h"
+#include "gambit/gamebagg.h"
+#include "gambit/nash/enumpure.h"
+
+namespace Gambit {
+namespace Nash {
+
+namespace {
+
+//
+// The best responses of the players of a table game.  Contingencies,
+// and profiles of the strategies of all players but one, are numbered
+// from zero, in the order of the payoff tables; these are the positions
+// of the iterators over them.  Best payoffs are held as pointers into
+// the payoff tables of the game, which are only read.
+//
+class TableBestResponses {
+public:
+  TableBestResponses(const Game &p_game);
+
+  /// Returns the number of players in the game
+  int NumPlayers(void) const { return m_numStrategies.Length(); }
+  /// Returns the number of profiles of the strategies of all but player pl
+  long NumProfiles(int pl) const
+  { return m_numContingencies / m_numStrategies[pl]; }
+  /// Returns the support of all strategies, which the iterators visit
+  const StrategySupportProfile &GetSupport(void) const { return m_support; }
+
+  /// Computes the best payoffs of player pl against the profiles
+  /// visited by p_iter, which holds player pl's first strategy fixed
+  void ComputeBest(int pl, StrategyProfileIterator &p_iter);
+  /// Appends the equilibria among the contingencies visited by p_iter
+  /// to p_found, stopping after p_stopAfter have been found, if it is
+  /// positive
+  void FindEquilibria(StrategyProfileIterator &p_iter, int p_stopAfter,
+		      std::vector<long> &p_found) const;
+
+private:
+  const GameTableRep &m_game;
+  StrategySupportProfile m_support;
+  long m_numContingencies;
+  Array<int> m_numStrategies;
+  /// The distance between contingencies differing by one strategy
+  Array<long> m_strides;
+  /// The best payoff of each player against each profile of the others
+  Array<std::vector<const Rational *> > m_best;
+};
+
+TableBestResponses::TableBestResponses(const Game &p_game)
+  : m_game(dynamic_cast<const GameTableRep &>(*p_game)), m_support(p_game),
+    m_numContingencies(1L),
+    m_numStrategies(p_game->NumPlayers()), m_strides(p_game->NumPlayers()),
+    m_best(p_game->NumPlayers())
+{
+  for (int pl = 1; pl <= m_numStrategies.Length(); pl++) {
+    m_numStrategies[pl] = p_game->GetPlayer(pl)->NumStrategies();
+    m_strides[pl] = m_numContingencies;
+    m_numContingencies *= m_numStrategies[pl];
+  }
+  for (int pl = 1; pl <= m_numStrategies.Length(); pl++) {
+    m_best[pl].resize(NumProfiles(pl));
+  }
+}
+
+void TableBestResponses::ComputeBest(int pl, StrategyProfileIterator &p_iter)
+{
+  long stride = m_strides[pl];
+  int numStrategies = m_numStrategies[pl];
+  for (; !p_iter.AtEnd(); p_iter++) {
+    // The index of the contingency at which player pl plays their
+    // first strategy
+    long index = p_iter.GetIndex();
+    const Rational *best = &m_game.GetPayoff<Rational>(index, pl);
+    for (int st = 1; st < numStrategies; st++) {
+      const Rational *payoff = &m_game.GetPayoff<Rational>(index + st * stride, pl);
+      if (*payoff > *best) {
+	best = payoff;
+      }
+    }
+    m_best[pl][p_iter.GetPosition()] = best;
+  }
+}
+
+void TableBestResponses::FindEquilibria(StrategyProfileIterator &p_iter,
+					int p_stopAfter,
+					std::vector<long> &p_found) const
+{
+  for (; !p_iter.AtEnd(); p_iter++) {
+    long cont = p_iter.GetPosition();
+    int pl = 1;
+    for (; pl <= m_numStrategies.Length(); pl++) {
+      long stride = m_strides[pl];
+      long profile = (cont % stride +
+		      (cont / (stride * m_numStrategies[pl])) * stride);
+      const Rational &payoff = m_game.GetPayoff<Rational>(cont + 1, pl);
+      const Rational *best = m_best[pl][profile];
+      if (best != &payoff && *best != payoff) {
+	break;
+      }
+    }
+    if (pl > m_numStrategies.Length()) {
+      p_found.push_back(cont);
+      if (p_stopAfter > 0 && (int) p_found.size() >= p_stopAfter) {
+	return;
+      }
+    }
+  }
+}
+
+//
+// The work of each thread in a step of the enumeration
+//
+class BestResponseTask : public ParallelTask {
+private:
+  TableBestResponses &m_responses;
+  int m_part, m_numParts;
+
+public:
+  BestResponseTask(TableBestResponses &p_responses, int p_part, int p_numParts)
+    : m_responses(p_responses), m_part(p_part), m_numParts(p_numParts) { }
+  virtual ~BestResponseTask() { }
+
+  virtual void Run(void)
+  {
+    for (int pl = 1; pl <= m_responses.NumPlayers(); pl++) {
+      StrategyProfileIterator iter(m_responses.GetSupport(), pl, 1);
+      Array<long> bounds = SplitContingencies(iter.NumContingencies(),
+					      m_numParts);
+      iter.SetRange(bounds[m_part], bounds[m_part + 1]);
+      m_responses.ComputeBest(pl, iter);
+    }
+  }
+};
+
+class EquilibriumTask : public ParallelTask {
+private:
+  const TableBestResponses &m_responses;
+  long m_begin, m_end;
+  int m_stopAfter;
+
+public:
+  std::vector<long> m_found;
+
+  EquilibriumTask(const TableBestResponses &p_responses,
+		  long p_begin, long p_end, int p_stopAfter)
+    : m_responses(p_responses), m_begin(p_begin), m_end(p_end),
+      m_stopAfter(p_stopAfter) { }
+  virtual ~EquilibriumTask() { }
+
+  virtual void Run(void)
+  {
+    StrategyProfileIterator iter(m_responses.GetSupport());
+    iter.SetRange(m_begin, m_end);
+    m_responses.FindEquilibria(iter, m_stopAfter, m_found);
+  }
+};
+
+//
+// Orders pure strategy profiles, referred to by their position in a
+// vector, with those later in contingency order first.  Profiles are
+// given by the index of each player's strategy, so this is the
+// lexicographic order from the last player.
+//
+class LaterContingency {
+private:
+  const std::vector<std::vector<int> > &m_profiles;
+
+public:
+  LaterContingency(const std::vector<std::vector<int> > &p_profiles)
+    : m_profiles(p_profiles) { }
+
+  bool operator()(size_t p_index1, size_t p_index2) const
+  {
+    const std::vector<int> &profile1 = m_profiles[p_index1];
+    const std::vector<int> &profile2 = m_profiles[p_index2];
+    return std::lexicographical_compare(profile2.rbegin(), profile2.rend(),
+					profile1.rbegin(), profile1.rend());
+  }
+};
+
+typedef std::priority_queue<size_t, std::vector<size_t>,
+			    LaterContingency> ProfileQueue;
+
+} // end anonymous namespace
+
+//========================================================================
+//                    class EnumPureStrategySolver
+//========================================================================
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::Solve(const Game &p_game) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  if (dynamic_cast<GameTableRep *>(p_game.operator->())) {
+    return SolveTable(p_game);
+  }
+  if (dynamic_cast<GameAggRep *>(p_game.operator->())) {
+    return SolveAgg(p_game);
+  }
+  if (dynamic_cast<GameBagentRep *>(p_game.operator->())) {
+    return SolveBagg(p_game);
+  }
+
+  List<MixedStrategyProfile<Rational> > solutions;
+  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+    if ((*citer)->IsNash()) {
+      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
+      m_onEquilibrium->Render(profile);
+      solutions.Append(profile);
+      if (m_stopAfter > 0 && solutions.Length() >= m_stopAfter) {
+	break;
+      }
+    }
+  }
+  return solutions;
+}
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::SolveTable(const Game &p_game) const
+{
+#ifdef GAMBIT_THREADS
+  int numThreads = std::max(1, m_numThreads);
+#else
+  int numThreads = 1;
+#endif  // GAMBIT_THREADS
+
+  if (numThreads > 1) {
+    p_game->PrepareForSharing();
+  }
+  TableBestResponses responses(p_game);
+
+  Array<ParallelTask *> bestTasks(numThreads);
+  for (int i = 1; i <= numThreads; i++) {
+    bestTasks[i] = new BestResponseTask(responses, i, numThreads);
+  }
+  RunParallelTasks(bestTasks);
+  for (int i = 1; i <= numThreads; i++) {
+    delete bestTasks[i];
+  }
+
+  // Each part stops after m_stopAfter equilibria of its own; the first
+  // m_stopAfter overall are then the first found in order of the parts
+  Array<long> bounds = SplitContingencies(responses.GetSupport(), numThreads);
+  Array<EquilibriumTask *> tasks(numThreads);
+  Array<ParallelTask *> equilibriumTasks(numThreads);
+  for (int i = 1; i <= numThreads; i++) {
+    tasks[i] = new EquilibriumTask(responses, bounds[i], bounds[i + 1],
+				   m_stopAfter);
+    equilibriumTasks[i] = tasks[i];
+  }
+  RunParallelTasks(equilibriumTasks);
+
+  List<MixedStrategyProfile<Rational> > solutions;
+  std::vector<int> profile(p_game->NumPlayers());
+  for (int i = 1; i <= numThreads; i++) {
+    for (size_t j = 0; j < tasks[i]->m_found.size(); j++) {
+      if (m_stopAfter > 0 && solutions.Length() >= m_stopAfter) {
+	break;
+      }
+      long cont = tasks[i]->m_found[j];
+      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	int numStrategies = p_game->GetPlayer(pl)->NumStrategies();
+	profile[pl - 1] = cont % numStrategies;
+	cont /= numStrategies;
+      }
+      Report(p_game, profile, solutions);
+    }
+    delete tasks[i];
+  }
+  return solutions;
+}
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::SolveAgg(const Game &p_game) const
+{
+  agg::AGG *aggPtr = dynamic_cast<GameAggRep &>(*p_game).aggPtr;
+  std::vector<std::vector<int> > configs;
+  aggPtr->getPureNash(configs);
+
+  // Each equilibrium configuration is shared by many profiles, which
+  // may be too many to hold.  The profiles of each are visited in
+  // contingency order, and merged, so as to report them in that order.
+  std::vector<std::vector<int> > profiles(configs.size());
+  ProfileQueue queue((LaterContingency(profiles)));
+  for (size_t i = 0; i < configs.size(); i++) {
+    aggPtr->firstPureProfile(profiles[i], configs[i]);
+    queue.push(i);
+  }
+  List<MixedStrategyProfile<Rational> > solutions;
+  while (!queue.empty() &&
+	 (m_stopAfter <= 0 || solutions.Length() < m_stopAfter)) {
+    size_t i = queue.top();
+    queue.pop();
+    Report(p_game, profiles[i], solutions);
+    if (aggPtr->nextPureProfile(profiles[i])) {
+      queue.push(i);
+    }
+  }
+  return solutions;
+}
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::SolveBagg(const Game &p_game) const
+{
+  std::vector<std::vector<int> > profiles;
+  dynamic_cast<GameBagentRep &>(*p_game).baggPtr->getPureNash(profiles);
+  List<MixedStrategyProfile<Rational> > solutions;
+  for (size_t i = 0; i < profiles.size(); i++) {
+    if (m_stopAfter > 0 && solutions.Length() >= m_stopAfter) {
+      break;
+    }
+    Report(p_game, profiles[i], solutions);
+  }
+  return solutions;
+}
+
+void
+EnumPureStrategySolver::Report(const Game &p_game,
+			       const std::vector<int> &p_profile,
+			       List<MixedStrategyProfile<Rational> > &p_solutions) const
+{
+  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    profile->SetStrategy(p_game->GetPlayer(pl)->GetStrategy(p_profile[pl - 1] + 1));
+  }
+  MixedStrategyProfile<Rational> mixed = profile->ToMixedStrategyProfile();
+  m_onEquilibrium->Render(mixed);
+  p_solutions.Append(mixed);
+}
+
+} // end namespace Nash
+} // end namespace Gambit
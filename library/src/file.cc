@@ -22,6 +22,8 @@
 
 #include <cstdlib>
 #include <cctype>
+#include <climits>
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <map>
@@ -29,6 +31,10 @@
 #include "gambit/gambit.h"
 // for explicit access to turning off canonicalization
 #include "gambit/gametree.h"
+// for storing payoffs of numeric games
+#include "gambit/gametable.h"
+// for the binary strategic game format
+#include "gambit/writer.h"
   
 
 namespace {
@@ -46,40 +52,75 @@ typedef enum {
 //! including the nonsignificance of whitespace and the possibility of
 //! escaped-quotes within text labels.
 //!
+//! The parser scans an in-memory copy of the file.  The text of numbers
+//! and symbols is located in place, and only copied out into a string
+//! when asked for, so that reading large payoff tables does not
+//! allocate a string per token.
+//!
 class GameParserState {
 private:
-  std::istream &m_file;
+  const char *m_data;
+  size_t m_length, m_position;
+  // End-of-file and failure states, with the semantics of std::istream
+  bool m_eof, m_fail;
 
   int m_currentLine;
   int m_currentColumn;
   GameFileToken m_lastToken;
-  std::string m_lastText;
+  mutable std::string m_lastText;
+  mutable bool m_textInBuffer;
+  const char *m_textBegin, *m_textEnd;
 
   void ReadChar(char& c);
   void UnreadChar(void);
   void IncreaseLine(void);
+  bool IsGood(void) const { return !m_eof && !m_fail; }
+  void SetTextInBuffer(const char *p_begin, const char *p_end)
+  { m_textBegin = p_begin;  m_textEnd = p_end;  m_textInBuffer = true; }
 
 public:
-  GameParserState(std::istream &p_file) :
-    m_file(p_file), m_currentLine(1), m_currentColumn(1) { }
+  GameParserState(const std::string &p_data) :
+    m_data(p_data.data()), m_length(p_data.length()), m_position(0),
+    m_eof(false), m_fail(false),
+    m_currentLine(1), m_currentColumn(1), m_textInBuffer(false) { }
 
   GameFileToken GetNextToken(void);
   GameFileToken GetCurrentToken(void) const { return m_lastToken; }
   int GetCurrentLine(void) const { return m_currentLine; }
   int GetCurrentColumn(void) const { return m_currentColumn; }
+  /// Returns the offset of the next unread character in the file
+  size_t GetPosition(void) const { return m_position; }
   std::string CreateLineMsg(const std::string &msg);
-  const std::string &GetLastText(void) const { return m_lastText; }
+  const std::string &GetLastText(void) const;
+  /// Returns the last text as an integer, with the semantics of atoi()
+  int GetLastInteger(void) const;
+  /// Returns the last text as a Rational, as lexical_cast<Rational>
+  Rational GetLastRational(void) const;
 };
 
 void GameParserState::ReadChar(char& c)
 {
-  m_file.get(c);
+  if (m_position < m_length) {
+    c = m_data[m_position++];
+  }
+  else {
+    m_eof = m_fail = true;
+    c = '\0';
+  }
   m_currentColumn++;
 }
 
 void GameParserState::UnreadChar(void)
 {
-  m_file.unget();
+  // As with std::istream::unget(), this clears the end of file state,
+  // but has no effect if a previous read has already failed.
+  m_eof = false;
+  if (!m_fail && m_position > 0) {
+    m_position--;
+  }
+  else {
+    m_fail = true;
+  }
   m_currentColumn--;
 }
 
@@ -89,16 +130,51 @@ void GameParserState::IncreaseLine(void){
   m_currentColumn = 1;
 }
 
+const std::string &GameParserState::GetLastText(void) const
+{
+  if (m_textInBuffer) {
+    m_lastText.assign(m_textBegin, m_textEnd);
+    m_textInBuffer = false;
+  }
+  return m_lastText;
+}
+
+int GameParserState::GetLastInteger(void) const
+{
+  const char *pos = (m_textInBuffer) ? m_textBegin : m_lastText.data();
+  const char *end = (m_textInBuffer) ? m_textEnd : pos + m_lastText.length();
+  while (pos < end && isspace(*pos)) {
+    pos++;
+  }
+  bool negative = false;
+  if (pos < end && (*pos == '-' || *pos == '+')) {
+    negative = (*pos++ == '-');
+  }
+  int value = 0;
+  while (pos < end && isdigit(*pos)) {
+    value = 10 * value + (*pos++ - '0');
+  }
+  return (negative) ? -value : value;
+}
+
+Rational GameParserState::GetLastRational(void) const
+{
+  if (m_textInBuffer) {
+    return ToRational(m_textBegin, m_textEnd);
+  }
+  return lexical_cast<Rational>(m_lastText);
+}
+
 GameFileToken GameParserState::GetNextToken(void)
 {
   char c = ' ';
-  if (m_file.eof()) {
+  if (m_eof) {
     return (m_lastToken = TOKEN_EOF);
   }
 
   while (isspace(c)) {
     ReadChar(c);
-    if (!m_file.good()) {
+    if (!IsGood()) {
       return (m_lastToken = TOKEN_EOF);
     }
     else if (c == '\n') {
@@ -116,91 +192,67 @@ GameFileToken GameParserState::GetNextToken(void)
     return (m_lastToken = TOKEN_COMMA);
   }
   else if (isdigit(c) || c == '-' || c == '+') {
-    std::string buf;
-    buf += c;
+    // The text of the number is everything consumed up to the point
+    // of returning, as any trailing character is put back.
+    const char *begin = m_data + m_position - 1;
     ReadChar(c);
 
-    while (!m_file.eof() && m_file.good() && isdigit(c)) {
-      buf += c;
+    while (IsGood() && isdigit(c)) {
       ReadChar(c);
     }
 
-    if (m_file.eof() || !m_file.good()) {
-      m_lastText = buf;
+    if (!IsGood()) {
+      SetTextInBuffer(begin, m_data + m_position);
       return (m_lastToken = TOKEN_NUMBER);
     }
 
     if (c == '.') {
-      buf += c;
       ReadChar(c);
       while (isdigit(c)) {
-        buf += c;
         ReadChar(c);
       }
 
       if (c == 'e' || c == 'E') {
-        buf += c;
         ReadChar(c);
         if (c == '+' && c == '-' && !isdigit(c)) {
           throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
         }
-        buf += c;
         ReadChar(c);
         while (isdigit(c)) {
-          buf += c;
           ReadChar(c);
         }
       }
-
-      UnreadChar();
-      m_lastText = buf;
-
-      return (m_lastToken = TOKEN_NUMBER);
     }
     else if (c == '/') {
-      buf += c;
       ReadChar(c);
       while (isdigit(c)) {
-        buf += c;
         ReadChar(c);
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
     }
     else if (c == 'e' || c == 'E') {
-      buf += c;
       ReadChar(c);
       if (c == '+' && c == '-' && !isdigit(c)) {
         throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
       }
-      buf += c;
       ReadChar(c);
       while (isdigit(c)) {
-        buf += c;
         ReadChar(c);
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else {
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
     }
+
+    UnreadChar();
+    SetTextInBuffer(begin, m_data + m_position);
+    return (m_lastToken = TOKEN_NUMBER);
   }
   else if (c == '.') {
-    std::string buf;
-    buf += c;
+    const char *begin = m_data + m_position - 1;
     ReadChar(c);
 
     while (isdigit(c)) {
-      buf += c;
       ReadChar(c);
     }
     UnreadChar();
-    m_lastText = buf;
+    SetTextInBuffer(begin, m_data + m_position);
     return (m_lastToken = TOKEN_NUMBER);
   }
 
@@ -210,6 +262,7 @@ GameFileToken GameParserState::GetNextToken(void)
     UnreadChar();
     char a;
 
+    m_textInBuffer = false;
     m_lastText = "";
 
     do  {
@@ -224,7 +277,7 @@ GameFileToken GameParserState::GetNextToken(void)
 
       ReadChar(a);
       while  (a != '\"' || lastslash)  {
-	if (m_file.eof() || !m_file.good())  {
+	if (!IsGood())  {
 	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
 	}
         if (lastslash && a == '"') {
@@ -245,7 +298,7 @@ GameFileToken GameParserState::GetNextToken(void)
       do  {
       	m_lastText += a;
         ReadChar(a);
-	if (m_file.eof() || !m_file.good())  {
+	if (!IsGood())  {
 	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
 	}
         if (a == '\n') {
@@ -257,11 +310,12 @@ GameFileToken GameParserState::GetNextToken(void)
     return (m_lastToken = TOKEN_TEXT);
   }
 
-  m_lastText = "";
-  while (!isspace(c) && !m_file.eof()) {
-    m_lastText += c;
+  const char *begin = m_data + m_position - 1;
+  while (!isspace(c) && !m_eof) {
     ReadChar(c);
   }
+  // The terminating whitespace character, if any, is not part of the text
+  SetTextInBuffer(begin, m_data + m_position - ((m_eof) ? 0 : 1));
   return (m_lastToken = TOKEN_SYMBOL);
 }
 
@@ -457,7 +511,7 @@ void ReadStrategies(GameParserState &p_state, TableFileGame &p_data)
           "Not enough players for number of strategy entries"));
       }
 
-      for (int st = 1; st <= atoi(p_state.GetLastText().c_str()); st++) {
+      for (int st = 1; st <= p_state.GetLastInteger(); st++) {
         player->m_strategies.Append(lexical_cast<std::string>(st));
       }
 
@@ -513,7 +567,23 @@ void ParseNfgHeader(GameParserState &p_state, TableFileGame &p_data)
 }
 
 
-void ReadOutcomeList(GameParserState &p_parser, GameRep *p_nfg)
+//
+// Converts the text of a payoff to floating point, as required
+// for numeric games.  This goes via Rational so that the value is the
+// same as the floating-point value of the corresponding Number.
+//
+double ParseNumericPayoff(const GameParserState &p_parser)
+{
+  return (double) p_parser.GetLastRational();
+}
+
+//
+// Reads the list of outcomes.  If p_payoffs is non-null, the payoffs
+// of each outcome are stored there instead of creating outcomes
+// in the game; this is used for numeric games, which have no outcomes.
+//
+void ReadOutcomeList(GameParserState &p_parser, GameRep *p_nfg,
+		     Array<Array<double> > *p_payoffs = 0)
 {
   if (p_parser.GetNextToken() == TOKEN_RBRACE) {
     // Special case: empty outcome list
@@ -538,20 +608,31 @@ void ReadOutcomeList(GameParserState &p_parser, GameRep *p_nfg)
     }
 
     GameOutcome outcome;
-    try {
-      outcome = p_nfg->GetOutcome(nOutcomes);
+    if (p_payoffs) {
+      p_payoffs->Append(Array<double>(p_nfg->NumPlayers()));
     }
-    catch (IndexException &) {
-      // It might happen that the file contains more outcomes than
-      // contingencies.  If so, just create them on the fly.
-      outcome = p_nfg->NewOutcome();
+    else {
+      try {
+	outcome = p_nfg->GetOutcome(nOutcomes);
+      }
+      catch (IndexException &) {
+	// It might happen that the file contains more outcomes than
+	// contingencies.  If so, just create them on the fly.
+	outcome = p_nfg->NewOutcome();
+      }
+      outcome->SetLabel(p_parser.GetLastText());
     }
-    outcome->SetLabel(p_parser.GetLastText());
     p_parser.GetNextToken();
 
     try {
       while (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-        outcome->SetPayoff(pl++, p_parser.GetLastText());
+	if (p_payoffs) {
+	  (*p_payoffs)[nOutcomes][pl++] =
+	    ParseNumericPayoff(p_parser);
+	}
+	else {
+	  outcome->SetPayoff(pl++, p_parser.GetLastText());
+	}
         if (p_parser.GetNextToken() == TOKEN_COMMA) {
             p_parser.GetNextToken();
         }
@@ -579,6 +660,54 @@ void ReadOutcomeList(GameParserState &p_parser, GameRep *p_nfg)
   p_parser.GetNextToken();
 }
 
+void ParseNumericOutcomeBody(GameParserState &p_parser, GameTableRep *p_nfg)
+{
+  Array<Array<double> > payoffs;
+  ReadOutcomeList(p_parser, p_nfg, &payoffs);
+
+  // Contingencies are listed in the order of the payoff tables
+  long cont = 1;
+  while (p_parser.GetCurrentToken() != TOKEN_EOF) {
+    if (p_parser.GetCurrentToken() != TOKEN_NUMBER) {
+      throw InvalidFileException(
+        p_parser.CreateLineMsg("Expecting outcome index"));
+    }
+
+    int outcomeId = p_parser.GetLastInteger();
+    if (outcomeId > 0)  {
+      if (outcomeId > payoffs.Length()) {
+	throw IndexException();
+      }
+      for (int pl = 1; pl <= p_nfg->NumPlayers(); pl++) {
+	p_nfg->SetPayoff(cont, pl, payoffs[outcomeId][pl]);
+      }
+    }
+    p_parser.GetNextToken();
+    cont++;
+  }
+}
+
+void ParseNumericPayoffBody(GameParserState &p_parser, GameTableRep *p_nfg)
+{
+  long cont = 1;
+  int pl = 1;
+
+  while (p_parser.GetCurrentToken() != TOKEN_EOF) {
+    if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
+      p_nfg->SetPayoff(cont, pl, ParseNumericPayoff(p_parser));
+    }
+    else {
+      throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
+    }
+
+    if (++pl > p_nfg->NumPlayers()) {
+      cont++;
+      pl = 1;
+    }
+    p_parser.GetNextToken();
+  }
+}
+
 void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
 {
   ReadOutcomeList(p_parser, p_nfg);
@@ -591,7 +720,7 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
         p_parser.CreateLineMsg("Expecting outcome index"));
     }
 
-    int outcomeId = atoi(p_parser.GetLastText().c_str());
+    int outcomeId = p_parser.GetLastInteger();
     if (outcomeId > 0)  {
       (*iter)->SetOutcome(p_nfg->GetOutcome(outcomeId));
     }
@@ -603,35 +732,37 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
   }
 }
 
-void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
+void ParsePayoffBody(GameParserState &p_parser, GameTableRep *p_nfg)
 {
-  StrategyProfileIterator iter(StrategySupportProfile(static_cast<GameRep *>(p_nfg)));
+  // The payoffs are set without creating the outcome of each contingency
+  long cont = 1;
   int pl = 1;
 
   while (p_parser.GetCurrentToken() != TOKEN_EOF) {
     if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
+      p_nfg->SetPayoff(cont, pl, p_parser.GetLastText());
     }
     else {
       throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
     }
 
     if (++pl > p_nfg->NumPlayers()) {
-      iter++;
+      cont++;
       pl = 1;
     }
     p_parser.GetNextToken();
   }
 }
 
-Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
+Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data,
+	      bool p_numeric)
 {
   Array<int> dim(p_data.NumPlayers());
   for (int pl = 1; pl <= dim.Length(); pl++) {
     dim[pl] = p_data.NumStrategies(pl);
   }
 
-  GameRep *nfg = NewTable(dim);
+  GameRep *nfg = NewTable(dim, false, p_numeric);
   // Assigning this to the container assures that, if something goes
   // wrong, the class will automatically be cleaned up
   Game game = nfg;
@@ -647,10 +778,20 @@ Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
   }
 
   if (p_parser.GetCurrentToken() == TOKEN_LBRACE) {
-    ParseOutcomeBody(p_parser, nfg);
+    if (p_numeric) {
+      ParseNumericOutcomeBody(p_parser, dynamic_cast<GameTableRep *>(nfg));
+    }
+    else {
+      ParseOutcomeBody(p_parser, nfg);
+    }
   }
   else if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-    ParsePayoffBody(p_parser, nfg);
+    if (p_numeric) {
+      ParseNumericPayoffBody(p_parser, dynamic_cast<GameTableRep *>(nfg));
+    }
+    else {
+      ParsePayoffBody(p_parser, dynamic_cast<GameTableRep *>(nfg));
+    }
   }
   else {
     throw InvalidFileException(
@@ -712,7 +853,7 @@ void ParseOutcome(GameParserState &p_state,
       p_state.CreateLineMsg("Expecting index of outcome"));
   }
 
-  int outcomeId = atoi(p_state.GetLastText().c_str());
+  int outcomeId = p_state.GetLastInteger();
   p_state.GetNextToken();
 
   if (p_state.GetCurrentToken() == TOKEN_TEXT) {
@@ -791,7 +932,7 @@ void ParseChanceNode(GameParserState &p_state,
     throw InvalidFileException(p_state.CreateLineMsg("Expecting infoset id"));
   }
 
-  int infosetId = atoi(p_state.GetLastText().c_str());
+  int infosetId = p_state.GetLastInteger();
   GameInfoset infoset;
   if (p_treeData.m_chanceInfosetMap.count(infosetId)) {
     infoset = p_treeData.m_chanceInfosetMap[infosetId];
@@ -869,7 +1010,7 @@ void ParsePersonalNode(GameParserState &p_state,
   if (p_state.GetNextToken() != TOKEN_NUMBER) {
     throw InvalidFileException(p_state.CreateLineMsg("Expecting player id"));
   }
-  int playerId = atoi(p_state.GetLastText().c_str());
+  int playerId = p_state.GetLastInteger();
   // This will throw an exception if the player ID is not valid
   GamePlayer player = p_game->GetPlayer(playerId);
   std::map<int, GameInfoset> &infosetMap = p_treeData.m_infosetMap[playerId];
@@ -877,7 +1018,7 @@ void ParsePersonalNode(GameParserState &p_state,
   if (p_state.GetNextToken() != TOKEN_NUMBER) {
     throw InvalidFileException(p_state.CreateLineMsg("Expecting infoset id"));
   }
-  int infosetId = atoi(p_state.GetLastText().c_str());
+  int infosetId = p_state.GetLastInteger();
   GameInfoset infoset;
   if (infosetMap.count(infosetId)) {
     infoset = infosetMap[infosetId];
@@ -994,6 +1135,150 @@ void ParseEfg(GameParserState &p_state, Game p_game, TreeData &p_treeData)
   ParseNode(p_state, p_game, p_game->GetRoot(), p_treeData);
 }
 
+//=========================================================================
+//                  Reading the binary strategic format
+//=========================================================================
+
+//
+// The format is documented with NfgBinaryGameWriter.  The payoff tables
+// are read in a single block per player directly into the storage of
+// the game, with no parsing of individual payoffs.
+//
+
+unsigned int ReadBinaryInteger(std::istream &p_file)
+{
+  unsigned char bytes[4];
+  if (!p_file.read((char *) bytes, 4)) {
+    throw InvalidFileException("Unexpected end of binary game file");
+  }
+  return ((unsigned int) bytes[0] | ((unsigned int) bytes[1] << 8) |
+	  ((unsigned int) bytes[2] << 16) | ((unsigned int) bytes[3] << 24));
+}
+
+//
+// Returns the number of bytes left to read in the file, or -1 if the
+// stream cannot be positioned, as when reading from a pipe.
+//
+std::streamoff RemainingBinaryBytes(std::istream &p_file)
+{
+  std::streampos here = p_file.tellg();
+  if (here == std::streampos(-1)) {
+    p_file.clear();
+    return -1;
+  }
+  p_file.seekg(0, std::ios::end);
+  std::streampos end = p_file.tellg();
+  p_file.clear();
+  p_file.seekg(here);
+  if (end == std::streampos(-1) || !p_file) {
+    p_file.clear();
+    return -1;
+  }
+  return end - here;
+}
+
+std::string ReadBinaryString(std::istream &p_file)
+{
+  unsigned int length = ReadBinaryInteger(p_file);
+  if ((std::streamoff) length > RemainingBinaryBytes(p_file)) {
+    throw InvalidFileException("Invalid string length in binary game file");
+  }
+  std::string value(length, ' ');
+  if (length > 0 && !p_file.read(&value[0], length)) {
+    throw InvalidFileException("Unexpected end of binary game file");
+  }
+  return value;
+}
+
+void ReadBinaryDoubles(std::istream &p_file, double *p_values, long p_count)
+{
+  if (!p_file.read((char *) p_values, p_count * sizeof(double))) {
+    throw InvalidFileException("Unexpected end of binary game file");
+  }
+  unsigned int one = 1;
+  if (*((unsigned char *) &one) != 1) {
+    // The file is little-endian, so reverse the bytes of each value
+    char *bytes = (char *) p_values;
+    for (long i = 0; i < p_count; i++, bytes += sizeof(double)) {
+      for (int j = 0; j < (int) sizeof(double) / 2; j++) {
+	std::swap(bytes[j], bytes[sizeof(double) - 1 - j]);
+      }
+    }
+  }
+}
+
+//
+// Reads the game from the number of players on, from a stream which
+// can report how much of it remains
+//
+Game ReadNfgBinaryContents(std::istream &p_file)
+{
+  unsigned int players = ReadBinaryInteger(p_file);
+  if (players == 0) {
+    throw InvalidFileException("Binary game file has no players");
+  }
+  if (players > (unsigned int) INT_MAX ||
+      (std::streamoff) players > RemainingBinaryBytes(p_file) / 4) {
+    throw InvalidFileException("Invalid number of players in binary game file");
+  }
+  Array<int> dim(players);
+  long ncont = 1;
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    unsigned int strategies = ReadBinaryInteger(p_file);
+    if (strategies == 0 || strategies > (unsigned int) INT_MAX ||
+	ncont > INT_MAX / (long) strategies) {
+      throw InvalidFileException("Invalid dimensions in binary game file");
+    }
+    dim[pl] = strategies;
+    ncont *= strategies;
+  }
+
+  // The payoff tables are allocated before they are read
+  if (ncont > RemainingBinaryBytes(p_file) /
+      (std::streamoff) (dim.Length() * sizeof(double))) {
+    throw InvalidFileException("Unexpected end of binary game file");
+  }
+
+  Game game = NewTable(dim, false, true);
+  game->SetTitle(ReadBinaryString(p_file));
+  game->SetComment(ReadBinaryString(p_file));
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    game->GetPlayer(pl)->SetLabel(ReadBinaryString(p_file));
+  }
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    for (int st = 1; st <= dim[pl]; st++) {
+      game->GetPlayer(pl)->GetStrategy(st)->SetLabel(ReadBinaryString(p_file));
+    }
+  }
+
+  GameTableRep &table = dynamic_cast<GameTableRep &>(*game);
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    ReadBinaryDoubles(p_file, &table.ModifyPayoffTable(pl)[1], ncont);
+  }
+  return game;
+}
+
+Game ReadNfgBinary(std::istream &p_file)
+{
+  char magic[8];
+  if (!p_file.read(magic, 8) || 
+      std::string(magic, 8) != std::string(NfgBinaryGameWriter::Magic, 8)) {
+    throw InvalidFileException("Not a binary game file");
+  }
+  if (ReadBinaryInteger(p_file) > NfgBinaryGameWriter::Version) {
+    throw InvalidFileException("Unsupported version of binary game file");
+  }
+  if (RemainingBinaryBytes(p_file) < 0) {
+    // As for the text formats, a stream which cannot be positioned is
+    // read into memory first, so the sizes given in the file can be
+    // checked against what it holds before anything is allocated
+    std::stringstream buffer;
+    buffer << p_file.rdbuf();
+    return ReadNfgBinaryContents(buffer);
+  }
+  return ReadNfgBinaryContents(p_file);
+}
+
 } // end of anonymous namespace
 
 
@@ -1051,19 +1336,23 @@ Game GameXMLSavefile::GetGame(void) const
 //    ReadGame: Global visible function to read an .efg or .nfg file
 //=========================================================================
 
-Game ReadGame(std::istream &p_file) throw (InvalidFileException)
+Game ReadGame(std::istream &p_file, bool p_numeric)
+  throw (InvalidFileException)
 {
+  if (p_file.peek() == (unsigned char) NfgBinaryGameWriter::Magic[0]) {
+    return ReadNfgBinary(p_file);
+  }
+
   std::stringstream buffer;
   buffer << p_file.rdbuf();
+  const std::string contents = buffer.str();
   try {
-    GameXMLSavefile doc(buffer.str());
+    GameXMLSavefile doc(contents);
     return doc.GetGame();
   }
-  catch (InvalidFileException) {
-    buffer.seekg(0, std::ios::beg);
-  }
+  catch (InvalidFileException) { }
 
-  GameParserState parser(buffer);
+  GameParserState parser(contents);
   try {
     if (parser.GetNextToken() != TOKEN_SYMBOL) {
       throw InvalidFileException(parser.CreateLineMsg("Expecting file type"));
@@ -1072,7 +1361,7 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
     if (parser.GetLastText() == "NFG") {
       TableFileGame data;
       ParseNfgHeader(parser, data);
-      return BuildNfg(parser, data);
+      return BuildNfg(parser, data, p_numeric);
     }
     else if (parser.GetLastText() == "EFG") {
       TreeData treeData;
@@ -1083,9 +1372,11 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
       return game;
     }
     else if (parser.GetLastText() == "#AGG") {
+      buffer.seekg(parser.GetPosition());
       return GameAggRep::ReadAggFile(buffer);
     }
     else if (parser.GetLastText() == "#BAGG") {
+      buffer.seekg(parser.GetPosition());
       return GameBagentRep::ReadBaggFile(buffer);
     }
     else {
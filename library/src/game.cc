@@ -189,10 +189,11 @@ GameInfoset GamePlayerRep::GetInfoset(int p_index) const { return m_infosets[p_i
 //========================================================================
 
 PureStrategyProfileRep::PureStrategyProfileRep(const Game &p_game) 
-  : m_nfg(p_game), m_profile(p_game->Players().size())
+  : m_nfg(p_game), m_profile(p_game->Players().size()), m_index(1L)
 {
   for (int pl = 1; pl <= m_nfg->Players().size(); pl++)  {
     m_profile[pl] = m_nfg->GetPlayer(pl)->GetStrategy(1);
+    m_index += m_profile[pl]->m_offset;
   }
 }
 
@@ -22,52 +22,100 @@
 
 #include <iostream>
 #include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
 
 namespace Gambit {
 
+//========================================================================
+//                        class OutcomeIndexTable
+//========================================================================
+
+void OutcomeIndexTable::Repack(int p_width)
+{
+  std::vector<unsigned char> data(m_length * p_width, 0);
+  for (long i = 1; i <= m_length; i++) {
+    int outcome = (*this)[i];
+    switch (p_width) {
+    case 1:
+      data[i - 1] = (unsigned char) outcome;
+      break;
+    case 2:
+      reinterpret_cast<unsigned short *>(&data[0])[i - 1] = 
+	(unsigned short) outcome;
+      break;
+    default:
+      reinterpret_cast<unsigned int *>(&data[0])[i - 1] = 
+	(unsigned int) outcome;
+      break;
+    }
+  }
+  m_data.swap(data);
+  m_width = p_width;
+}
+
+int OutcomeIndexTable::Max(void) const
+{
+  int max = 0;
+  for (long i = 1; i <= m_length; i++) {
+    max = std::max(max, (*this)[i]);
+  }
+  return max;
+}
+
+int OutcomeIndexTable::Pack(void)
+{
+  int max = Max();
+  int width = (max > 0xffff) ? 4 : ((max > 0xff) ? 2 : 1);
+  if (width < m_width) {
+    Repack(width);
+  }
+  return max;
+}
+
 //========================================================================
 //                  class TablePureStrategyProfileRep
 //========================================================================
 
 class TablePureStrategyProfileRep : public PureStrategyProfileRep {
 protected:
-  long m_index;
+  /// The game, which is also held by m_nfg
+  GameTableRep *m_table;
 
   virtual PureStrategyProfileRep *Copy(void) const;
 
 public:
-  TablePureStrategyProfileRep(const Game &p_game);
+  TablePureStrategyProfileRep(GameTableRep *p_game);
   virtual long GetIndex(void) const { return m_index; }
   virtual void SetStrategy(const GameStrategy &);
   virtual GameOutcome GetOutcome(void) const;
   virtual void SetOutcome(GameOutcome p_outcome);
   virtual Rational GetPayoff(int pl) const;
   virtual Rational GetStrategyValue(const GameStrategy &) const;
+  virtual bool IsNash(void) const;
 };
 
 //------------------------------------------------------------------------
 //               TablePureStrategyProfileRep: Lifecycle
 //------------------------------------------------------------------------
 
-TablePureStrategyProfileRep::TablePureStrategyProfileRep(const Game &p_nfg)
-  : PureStrategyProfileRep(p_nfg), m_index(1L)
-{
-  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++)   {
-    m_index += m_profile[pl]->m_offset;
-  }
-}
+TablePureStrategyProfileRep::TablePureStrategyProfileRep(GameTableRep *p_nfg)
+  : PureStrategyProfileRep(p_nfg), m_table(p_nfg)
+{ }
 
 PureStrategyProfileRep *TablePureStrategyProfileRep::Copy(void) const
 {
   return new TablePureStrategyProfileRep(*this);
 }
 
-Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes /*= false*/)
+Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes /*= false*/,
+	      bool p_numeric /*= false*/)
 {
-  return new GameTableRep(p_dim, p_sparseOutcomes);
+  return new GameTableRep(p_dim, p_sparseOutcomes, p_numeric);
 }
 
 //------------------------------------------------------------------------
@@ -82,36 +130,51 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  if (m_table->m_numeric) {
+    throw UndefinedException("Numeric games do not have outcomes");
+  }
+  int outcome = m_table->m_results[m_index];
+  return (outcome) ? m_table->MaterializeOutcome(outcome) : 0;
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  if (m_table->m_numeric) {
+    throw UndefinedException("Numeric games do not have outcomes");
+  }
+  m_table->SetOutcomeIndex(m_index, p_outcome);
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
-  if (outcome) {
-    return outcome->GetPayoff<Rational>(pl);
-  }
-  else {
-    return 0;
-  }
+  return m_table->GetPayoff<Rational>(m_index, pl);
 }
 
 Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
-  if (outcome) {
-    return outcome->GetPayoff<Rational>(player);
-  }
-  else {
-    return 0;
+  return m_table->GetPayoff<Rational>(m_index - m_profile[player]->m_offset + p_strategy->m_offset, player);
+}
+
+//
+// The payoffs of the deviations of each player are read directly
+// from the game by their indices, without copying them.
+//
+bool TablePureStrategyProfileRep::IsNash(void) const
+{
+  for (int pl = 1; pl <= m_table->m_players.Length(); pl++) {
+    const GameStrategyArray &strategies = m_table->m_players[pl]->Strategies();
+    long base = m_index - m_profile[pl]->m_offset;
+    const Rational &current = m_table->GetPayoff<Rational>(m_index, pl);
+    for (int st = 1; st <= strategies.Length(); st++) {
+      if (m_table->GetPayoff<Rational>(base + strategies[st]->m_offset,
+				       pl) > current) {
+	return false;
+      }
+    }
   }
+  return true;
 }
 
 PureStrategyProfile GameTableRep::NewPureStrategyProfile(void) const
@@ -139,9 +202,13 @@ int Product(const Array<int> &dim)
 
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
-			   bool p_sparseOutcomes /* = false */)
+			   bool p_sparseOutcomes /* = false */,
+			   bool p_numeric /* = false */)
+  : m_implicitOutcomes(0), m_maxOutcome(0), m_maxOutcomeValid(true),
+    m_numeric(p_numeric),
+    m_doublePayoffsValid(false), m_rationalPayoffsValid(false),
+    m_doubleOutcomePayoffsValid(false), m_rationalOutcomePayoffsValid(false)
 {
-  m_results = Array<GameOutcomeRep *>(Product(dim));
   for (int pl = 1; pl <= dim.Length(); pl++)  {
     m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
     m_players[pl]->m_label = lexical_cast<std::string>(pl);
@@ -151,25 +218,90 @@ GameTableRep::GameTableRep(const Array<int> &dim,
   }
   IndexStrategies();
 
-  if (p_sparseOutcomes) {
-    for (int cont = 1; cont <= m_results.Length();
-	 m_results[cont++] = 0);
+  if (m_numeric) {
+    // The floating-point tables are the only copy of the payoffs,
+    // so they are always valid
+    m_doublePayoffs = Array<PayoffTable<double> >(dim.Length());
+    for (int pl = 1; pl <= dim.Length(); pl++) {
+      Array<double> &payoffs = m_doublePayoffs[pl].Modify();
+      payoffs = Array<double>(Product(dim));
+      for (int cont = 1; cont <= payoffs.Length(); payoffs[cont++] = 0.0);
+    }
+    m_doublePayoffsValid = true;
+    return;
+  }
+
+  m_results = OutcomeIndexTable(Product(dim));
+  if (!p_sparseOutcomes) {
+    // The outcomes are created as they are asked for; until the first
+    // one is, not even m_outcomes is allocated
+    for (long cont = 1; cont <= m_results.Length(); cont++) {
+      m_results.Set(cont, cont);
+    }
+    m_implicitOutcomes = m_results.Length();
+    m_maxOutcome = m_implicitOutcomes;
   }
-  else {
-    m_outcomes = Array<GameOutcomeRep *>(m_results.Length());
-    for (int i = 1; i <= m_outcomes.Length(); i++) {
-      m_outcomes[i] = new GameOutcomeRep(this, i);
+}
+
+GameTableRep::~GameTableRep()
+{
+  // Outcomes not yet created are null, so the outcomes are
+  // released here rather than by GameExplicitRep
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    if (m_outcomes[outc]) {
+      m_outcomes[outc]->Invalidate();
     }
-    m_results = m_outcomes;
   }
+  m_outcomes = Array<GameOutcomeRep *>();
 }
 
+//
+// The copy is built directly from the players, strategies and outcomes
+// of the game.  The payoff tables are shared with the copy until either
+// game changes them.  As when the game is written out and read back in,
+// the copy is not a restriction, even if the game is.
+//
 Game GameTableRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  Array<int> dim(m_players.Length());
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    dim[pl] = m_players[pl]->m_strategies.Length();
+  }
+  GameTableRep *copy = new GameTableRep(dim, true, m_numeric);
+  copy->m_title = m_title;
+  copy->m_comment = m_comment;
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    copy->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= dim[pl]; st++) {
+      copy->m_players[pl]->m_strategies[st]->m_label = 
+	m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+
+  copy->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    if (!m_outcomes[outc]) {
+      // Outcomes not yet created are not created in the copy either
+      copy->m_outcomes[outc] = 0;
+      continue;
+    }
+    GameOutcomeRep *outcome = new GameOutcomeRep(copy, outc);
+    outcome->m_label = m_outcomes[outc]->m_label;
+    outcome->m_payoffs = m_outcomes[outc]->m_payoffs;
+    copy->m_outcomes[outc] = outcome;
+  }
+  copy->m_implicitOutcomes = m_implicitOutcomes;
+  copy->m_implicitPayoffs = m_implicitPayoffs;
+  copy->m_results = m_results;
+  copy->m_maxOutcome = m_maxOutcome;
+  copy->m_maxOutcomeValid = m_maxOutcomeValid;
+
+  copy->m_doublePayoffs = m_doublePayoffs;
+  copy->m_doublePayoffsValid = m_doublePayoffsValid;
+  copy->m_rationalPayoffs = m_rationalPayoffs;
+  copy->m_rationalPayoffsValid = m_rationalPayoffsValid;
+  copy->m_changedOutcomes = m_changedOutcomes;
+  return copy;
 }
 
 //------------------------------------------------------------------------
@@ -178,18 +310,16 @@ Game GameTableRep::Copy(void) const
 
 bool GameTableRep::IsConstSum(void) const
 {
-  TablePureStrategyProfileRep profile(const_cast<GameTableRep *>(this));
-
+  long ncont = NumStrategyContingencies();
   Rational sum(0);
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    sum += profile.GetPayoff(pl);
+    sum += GetPayoff<Rational>(1, pl);
   }
 
-  for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
-       !iter.AtEnd(); iter++) {
+  for (long cont = 2; cont <= ncont; cont++) {
     Rational newsum(0);
     for (int pl = 1; pl <= m_players.Length(); pl++) {
-      newsum += (*iter)->GetPayoff(pl);
+      newsum += GetPayoff<Rational>(cont, pl);
     }
     
     if (newsum != sum) {
@@ -200,6 +330,77 @@ bool GameTableRep::IsConstSum(void) const
   return true;
 }
 
+//
+// Numeric games have no outcomes, so these are taken over their payoff
+// tables.  Otherwise, if there are outcomes not yet created, these are
+// taken over the payoffs held for them as well as the outcomes.
+//
+Rational GameTableRep::GetMinPayoff(int pl) const
+{
+  if (m_numeric) {
+    int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : m_players.Length();
+    Rational minpay = GetPayoffTable<Rational>(p1)[1];
+    for (int p = p1; p <= p2; p++) {
+      const Array<Rational> &payoffs = GetPayoffTable<Rational>(p);
+      for (int i = payoffs.First(); i <= payoffs.Last(); i++) {
+	if (payoffs[i] < minpay) {
+	  minpay = payoffs[i];
+	}
+      }
+    }
+    return minpay;
+  }
+  if (m_implicitOutcomes == 0) {
+    return GameExplicitRep::GetMinPayoff(pl);
+  }
+  int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : m_players.Length();
+  Rational minpay;
+  for (int outc = 1; outc <= NumOutcomes(); outc++) {
+    GameOutcomeRep *outcome = GetCreatedOutcome(outc);
+    for (int p = p1; p <= p2; p++) {
+      Rational payoff = (outcome) ? outcome->GetPayoff<Rational>(p) :
+	GetImplicitPayoff<Rational>(outc, p);
+      if ((outc == 1 && p == p1) || payoff < minpay) {
+	minpay = payoff;
+      }
+    }
+  }
+  return minpay;
+}
+
+Rational GameTableRep::GetMaxPayoff(int pl) const
+{
+  if (m_numeric) {
+    int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : m_players.Length();
+    Rational maxpay = GetPayoffTable<Rational>(p1)[1];
+    for (int p = p1; p <= p2; p++) {
+      const Array<Rational> &payoffs = GetPayoffTable<Rational>(p);
+      for (int i = payoffs.First(); i <= payoffs.Last(); i++) {
+	if (payoffs[i] > maxpay) {
+	  maxpay = payoffs[i];
+	}
+      }
+    }
+    return maxpay;
+  }
+  if (m_implicitOutcomes == 0) {
+    return GameExplicitRep::GetMaxPayoff(pl);
+  }
+  int p1 = (pl) ? pl : 1, p2 = (pl) ? pl : m_players.Length();
+  Rational maxpay;
+  for (int outc = 1; outc <= NumOutcomes(); outc++) {
+    GameOutcomeRep *outcome = GetCreatedOutcome(outc);
+    for (int p = p1; p <= p2; p++) {
+      Rational payoff = (outcome) ? outcome->GetPayoff<Rational>(p) :
+	GetImplicitPayoff<Rational>(outc, p);
+      if ((outc == 1 && p == p1) || payoff > maxpay) {
+	maxpay = payoff;
+      }
+    }
+  }
+  return maxpay;
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
@@ -218,6 +419,19 @@ std::string EscapeQuotes(const std::string &s)
   return ret;
 }
 
+/// Format a floating-point payoff so it reads back as the same number,
+/// preferring the shorter representation where it suffices.
+std::string FormatPayoff(double p_value)
+{
+  std::ostringstream s;
+  s << std::setprecision(15) << p_value;
+  if (std::strtod(s.str().c_str(), 0) != p_value) {
+    s.str("");
+    s << std::setprecision(17) << p_value;
+  }
+  return s.str();
+}
+
 }  // end anonymous namespace
 
 ///
@@ -251,13 +465,35 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
   p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
 
+  if (m_numeric) {
+    // Numeric games have no outcomes, so the payoff format is used
+    for (long cont = 1; cont <= m_doublePayoffs[1].Values().Length(); cont++) {
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	p_file << FormatPayoff(m_doublePayoffs[pl].Values()[cont]) << ' ';
+      }
+      p_file << '\n';
+    }
+    p_file << '\n';
+    return;
+  }
+
   int ncont = 1;
   for (int i = 1; i <= NumPlayers(); i++) {
     ncont *= m_players[i]->m_strategies.Length();
   }
 
   p_file << "{\n";
-  for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
+  for (int outc = 1; outc <= NumOutcomes(); outc++)   {
+    if (!GetCreatedOutcome(outc)) {
+      // This outcome has not been created, so has no label
+      p_file << "{ \"\" ";
+      for (int pl = 1; pl <= m_players.Length(); pl++)  {
+	p_file << ((m_implicitPayoffs.Length() > 0) ?
+		   (const std::string &) m_implicitPayoffs[pl][outc] : "0");
+	p_file << ((pl < m_players.Length()) ? ", " : " }\n");
+      }
+      continue;
+    }
     p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
     for (int pl = 1; pl <= m_players.Length(); pl++)  {
       p_file << (const std::string &) m_outcomes[outc]->m_payoffs[pl];
@@ -273,12 +509,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   p_file << "}\n";
   
   for (int cont = 1; cont <= ncont; cont++)  {
-    if (m_results[cont] != 0) {
-      p_file << m_results[cont]->m_number << ' ';
-    }
-    else {
-      p_file << "0 ";
-    }
+    p_file << m_results[cont] << ' ';
   }
 
   p_file << '\n';
@@ -294,9 +525,26 @@ GamePlayer GameTableRep::NewPlayer(void)
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
   for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
-    m_outcomes[outc]->m_payoffs.Append(Number());
+    if (m_outcomes[outc]) {
+      m_outcomes[outc]->m_payoffs.Append(Number());
+    }
+  }
+  if (m_implicitPayoffs.Length() > 0) {
+    m_implicitPayoffs.Append(Array<Number>(m_implicitPayoffs[1].Length()));
+  }
+  if (m_numeric) {
+    // The new player has one strategy, so the number of contingencies
+    // is unchanged
+    long ncont = 1;
+    for (int pl = 1; pl < m_players.Length(); pl++) {
+      ncont *= m_players[pl]->m_strategies.Length();
+    }
+    Array<double> payoffs(ncont);
+    for (long cont = 1; cont <= payoffs.Length(); payoffs[cont++] = 0.0);
+    m_doublePayoffs.Append(PayoffTable<double>(payoffs));
   }
   ClearComputedValues();
+  ClearPayoffTables();
   return player;
 }
 
@@ -306,16 +554,31 @@ GamePlayer GameTableRep::NewPlayer(void)
 
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
-  for (int i = 1; i <= m_results.Length(); i++) {
-    if (m_results[i] == p_outcome) {
-      m_results[i] = 0;
+  // Outcomes after the deleted one move down by one
+  int number = p_outcome->GetNumber();
+  for (long i = 1; i <= m_results.Length(); i++) {
+    int outcome = m_results[i];
+    if (outcome == number) {
+      m_results.Set(i, 0);
+    }
+    else if (outcome > number) {
+      m_results.Set(i, outcome - 1);
     }
   }
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
+  for (int pl = 1; pl <= m_implicitPayoffs.Length(); pl++) {
+    // Outcomes created by NewOutcome() have no entries here
+    if (number <= m_implicitPayoffs[pl].Length()) {
+      m_implicitPayoffs[pl].Remove(number);
+    }
+  }
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
-    m_outcomes[outc]->m_number = outc;
+    if (m_outcomes[outc]) {
+      m_outcomes[outc]->m_number = outc;
+    }
   }
   ClearComputedValues();
+  ClearPayoffTables();
 }
 
 //------------------------------------------------------------------------
@@ -357,8 +620,12 @@ void GameTableRep::RebuildTable(void)
     size *= m_players[pl]->NumStrategies();
   }
 
-  Array<GameOutcomeRep *> newResults(size);
-  for (int i = 1; i <= newResults.Length(); newResults[i++] = 0);
+  OutcomeIndexTable newResults((m_numeric) ? 0 : size);
+  Array<Array<double> > newPayoffs((m_numeric) ? m_players.Length() : 0);
+  for (int pl = 1; pl <= newPayoffs.Length(); pl++) {
+    newPayoffs[pl] = Array<double>(size);
+    for (long i = 1; i <= size; newPayoffs[pl][i++] = 0.0);
+  }
 
   for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
        !iter.AtEnd(); iter++) {
@@ -374,16 +641,314 @@ void GameTableRep::RebuildTable(void)
       }
     }
 
-    if (newindex >= 1) {
-      newResults[newindex] = m_results[iter.m_profile->GetIndex()];
+    if (newindex >= 1 && m_numeric) {
+      for (int pl = 1; pl <= m_players.Length(); pl++) {
+	newPayoffs[pl][newindex] = 
+	  m_doublePayoffs[pl].Values()[iter.m_profile->GetIndex()];
+      }
+    }
+    else if (newindex >= 1) {
+      newResults.Set(newindex, m_results[iter.m_profile->GetIndex()]);
     }
   }
 
   m_results = newResults;
+  for (int pl = 1; pl <= newPayoffs.Length(); pl++) {
+    m_doublePayoffs[pl] = PayoffTable<double>(newPayoffs[pl]);
+  }
+  ClearPayoffTables();
 
   IndexStrategies();
 }
 
+void GameTableRep::SetOutcomeIndex(long p_index, GameOutcomeRep *p_outcome)
+{
+  int number = (p_outcome) ? p_outcome->m_number : 0;
+  if (number > m_maxOutcome) {
+    // The outcome payoff tables only extend to the largest number
+    m_maxOutcome = number;
+    m_doubleOutcomePayoffsValid = m_rationalOutcomePayoffsValid = false;
+  }
+  else if (number < m_maxOutcome && m_results[p_index] == m_maxOutcome) {
+    // This may have been the last contingency with the largest number;
+    // m_maxOutcome remains an upper bound until it is recomputed
+    m_maxOutcomeValid = false;
+  }
+  m_results.Set(p_index, number);
+  if (m_doublePayoffsValid) {
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      m_doublePayoffs[pl].Modify()[p_index] = 
+	(p_outcome) ? p_outcome->GetPayoff<double>(pl) : 0.0;
+    }
+  }
+  if (m_rationalPayoffsValid) {
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      m_rationalPayoffs[pl].Modify()[p_index] = 
+	(p_outcome) ? p_outcome->GetPayoff<Rational>(pl) : Rational(0);
+    }
+  }
+}
+
+void GameTableRep::SetPayoff(long p_index, int pl, double p_value)
+{
+  if (!m_numeric) {
+    throw UndefinedException("Payoffs may only be set directly in numeric games");
+  }
+  m_doublePayoffs[pl].Modify()[p_index] = p_value;
+  if (m_rationalPayoffsValid) {
+    m_rationalPayoffs[pl].Modify()[p_index] = Rational(p_value);
+  }
+}
+
+void GameTableRep::SetPayoff(long p_index, int pl, const std::string &p_value)
+{
+  if (m_numeric) {
+    SetPayoff(p_index, pl, (double) lexical_cast<Rational>(p_value));
+    return;
+  }
+  int number = m_results[p_index];
+  if (number == 0) {
+    throw UndefinedException("The contingency has the null outcome");
+  }
+  GameOutcomeRep *outcome = GetCreatedOutcome(number);
+  if (outcome) {
+    outcome->SetPayoff(pl, p_value);
+    return;
+  }
+
+  if (m_implicitPayoffs.Length() == 0) {
+    m_implicitPayoffs = Array<Array<Number> >(m_players.Length());
+    for (int p = 1; p <= m_players.Length(); p++) {
+      m_implicitPayoffs[p] = Array<Number>(NumOutcomes());
+    }
+  }
+  Number &payoff = m_implicitPayoffs[pl][number];
+  payoff = p_value;
+  // An outcome not yet created is at no contingency but this one
+  if (m_doublePayoffsValid) {
+    m_doublePayoffs[pl].Modify()[p_index] = (const double &) payoff;
+  }
+  if (m_rationalPayoffsValid) {
+    m_rationalPayoffs[pl].Modify()[p_index] = (const Rational &) payoff;
+  }
+  if (m_doubleOutcomePayoffsValid && number <= m_doubleOutcomePayoffs[pl].Last()) {
+    m_doubleOutcomePayoffs[pl][number] = (const double &) payoff;
+  }
+  if (m_rationalOutcomePayoffsValid && number <= m_rationalOutcomePayoffs[pl].Last()) {
+    m_rationalOutcomePayoffs[pl][number] = (const Rational &) payoff;
+  }
+}
+
+Array<double> &GameTableRep::ModifyPayoffTable(int pl)
+{
+  if (!m_numeric) {
+    throw UndefinedException("Payoffs may only be set directly in numeric games");
+  }
+  m_rationalPayoffsValid = false;
+  return m_doublePayoffs[pl].Modify();
+}
+
+//
+// The outcome payoff tables are updated at once.  The entries of an
+// outcome in the dense tables are found by a pass over the outcome
+// index, so they are updated when the tables are next read, in one
+// pass for all the outcomes changed by then; only if many outcomes
+// change are the tables instead rebuilt.  Tables shared with a copy
+// of the game are copied when first updated.
+//
+void GameTableRep::UpdatePayoffTables(const GameOutcomeRep *p_outcome,
+				      int pl) const
+{
+  int number = p_outcome->m_number;
+  if (m_doubleOutcomePayoffsValid && number <= m_doubleOutcomePayoffs[pl].Last()) {
+    m_doubleOutcomePayoffs[pl][number] = p_outcome->GetPayoff<double>(pl);
+  }
+  if (m_rationalOutcomePayoffsValid && number <= m_rationalOutcomePayoffs[pl].Last()) {
+    m_rationalOutcomePayoffs[pl][number] = p_outcome->GetPayoff<Rational>(pl);
+  }
+  if (!m_doublePayoffsValid && !m_rationalPayoffsValid) {
+    return;
+  }
+  if (m_changedOutcomes.size() >= 64) {
+    m_doublePayoffsValid = m_rationalPayoffsValid = false;
+    m_changedOutcomes.clear();
+  }
+  else if (std::find(m_changedOutcomes.begin(), m_changedOutcomes.end(),
+		     number) == m_changedOutcomes.end()) {
+    m_changedOutcomes.push_back(number);
+  }
+}
+
+void GameTableRep::PatchPayoffTables(void) const
+{
+  std::vector<bool> changed(NumOutcomes() + 1, false);
+  for (size_t i = 0; i < m_changedOutcomes.size(); i++) {
+    changed[m_changedOutcomes[i]] = true;
+  }
+  m_changedOutcomes.clear();
+
+  for (long cont = 1; cont <= m_results.Length(); cont++) {
+    int number = m_results[cont];
+    if (!changed[number]) {
+      continue;
+    }
+    // Outcomes whose payoffs have changed have been created
+    GameOutcomeRep *outcome = m_outcomes[number];
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      if (m_doublePayoffsValid) {
+	m_doublePayoffs[pl].Modify()[cont] = outcome->GetPayoff<double>(pl);
+      }
+      if (m_rationalPayoffsValid) {
+	m_rationalPayoffs[pl].Modify()[cont] = outcome->GetPayoff<Rational>(pl);
+      }
+    }
+  }
+}
+
+template <class T>
+void GameTableRep::BuildPayoffTables(Array<PayoffTable<T> > &p_payoffs) const
+{
+  if (m_numeric) {
+    // Exact payoffs are the exact values of the floating-point payoffs
+    p_payoffs = Array<PayoffTable<T> >(m_players.Length());
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      const Array<double> &payoffs = m_doublePayoffs[pl].Values();
+      Array<T> &table = p_payoffs[pl].Modify();
+      table = Array<T>(payoffs.Length());
+      for (long cont = 1; cont <= payoffs.Length(); cont++) {
+	table[cont] = T(payoffs[cont]);
+      }
+    }
+    return;
+  }
+
+  p_payoffs = Array<PayoffTable<T> >(m_players.Length());
+  Array<Array<T> *> tables(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    tables[pl] = &p_payoffs[pl].Modify();
+    *tables[pl] = Array<T>(m_results.Length());
+  }
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    int number = m_results[cont];
+    GameOutcomeRep *outcome = (number) ? GetCreatedOutcome(number) : 0;
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      (*tables[pl])[cont] = (outcome) ? outcome->GetPayoff<T>(pl) :
+	((number) ? GetImplicitPayoff<T>(number, pl) : T(0));
+    }
+  }
+}
+
+template void GameTableRep::BuildPayoffTables(Array<PayoffTable<double> > &) const;
+template void GameTableRep::BuildPayoffTables(Array<PayoffTable<Rational> > &) const;
+
+template <class T>
+void GameTableRep::BuildOutcomePayoffs(Array<Array<T> > &p_payoffs) const
+{
+  // Outcomes beyond m_maxOutcome are not at any contingency
+  int maxOutcome = std::min(m_maxOutcome, NumOutcomes());
+  p_payoffs = Array<Array<T> >(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    Array<T> &payoffs = p_payoffs[pl];
+    payoffs = Array<T>(0, maxOutcome);
+    payoffs[0] = T(0);
+    for (int outc = 1; outc <= maxOutcome; outc++) {
+      GameOutcomeRep *outcome = GetCreatedOutcome(outc);
+      payoffs[outc] = (outcome) ? 
+	outcome->GetPayoff<T>(pl) : GetImplicitPayoff<T>(outc, pl);
+    }
+  }
+}
+
+template void GameTableRep::BuildOutcomePayoffs(Array<Array<double> > &) const;
+template void GameTableRep::BuildOutcomePayoffs(Array<Array<Rational> > &) const;
+
+//
+// Stored outcome numbers tend to be much smaller than the number of
+// outcomes after a dense table is filled in, for example, when reading
+// a file which lists its outcomes; the index is narrowed accordingly.
+//
+void GameTableRep::ComputeMaxOutcome(void) const
+{
+  GameTableRep *self = const_cast<GameTableRep *>(this);
+  m_maxOutcome = self->m_results.Pack();
+  m_maxOutcomeValid = true;
+}
+
+void GameTableRep::AllocateOutcomes(void) const
+{
+  if (m_outcomes.Length() == 0 && m_implicitOutcomes > 0) {
+    GameTableRep *self = const_cast<GameTableRep *>(this);
+    self->m_outcomes = Array<GameOutcomeRep *>(m_implicitOutcomes);
+    for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+      self->m_outcomes[outc] = 0;
+    }
+  }
+}
+
+//
+// Threads sharing the game may ask for an outcome not yet created at
+// the same time; each creates it, and the first to store it wins.
+// PrepareForSharing() has allocated m_outcomes by then.
+//
+GameOutcomeRep *GameTableRep::MaterializeOutcome(int p_index) const
+{
+  AllocateOutcomes();
+  GameOutcomeRep *outcome = m_outcomes[p_index];
+  if (!outcome) {
+    GameTableRep *self = const_cast<GameTableRep *>(this);
+    outcome = new GameOutcomeRep(self, p_index);
+    for (int pl = 1; pl <= m_implicitPayoffs.Length(); pl++) {
+      outcome->m_payoffs[pl] = m_implicitPayoffs[pl][p_index];
+    }
+#ifdef GAMBIT_THREADS
+    if (!__sync_bool_compare_and_swap(&self->m_outcomes[p_index],
+				      (GameOutcomeRep *) 0, outcome)) {
+      delete outcome;
+      return m_outcomes[p_index];
+    }
+    __sync_sub_and_fetch(&self->m_implicitOutcomes, 1);
+#else
+    self->m_outcomes[p_index] = outcome;
+    self->m_implicitOutcomes--;
+#endif  // GAMBIT_THREADS
+  }
+  return outcome;
+}
+
+//
+// Outcomes not yet created are left so; only the null entries for them
+// are allocated, so that they can be created safely on first access
+// (see MaterializeOutcome()).  Their payoffs are in the payoff tables
+// built here.
+//
+void GameTableRep::PrepareForSharing(void)
+{
+  GameRep::PrepareForSharing();
+  AllocateOutcomes();
+  if (!m_changedOutcomes.empty()) {
+    PatchPayoffTables();
+  }
+  if (!m_maxOutcomeValid) {
+    ComputeMaxOutcome();
+  }
+  if (!m_doublePayoffsValid) {
+    BuildPayoffTables(m_doublePayoffs);
+    m_doublePayoffsValid = true;
+  }
+  if (!m_rationalPayoffsValid) {
+    BuildPayoffTables(m_rationalPayoffs);
+    m_rationalPayoffsValid = true;
+  }
+  if (!m_doubleOutcomePayoffsValid) {
+    BuildOutcomePayoffs(m_doubleOutcomePayoffs);
+    m_doubleOutcomePayoffsValid = true;
+  }
+  if (!m_rationalOutcomePayoffsValid) {
+    BuildOutcomePayoffs(m_rationalOutcomePayoffs);
+    m_rationalOutcomePayoffsValid = true;
+  }
+}
+
 void GameTableRep::IndexStrategies(void)
 {
   long offset = 1L;
@@ -435,10 +435,7 @@ void GameTreeNodeRep::MoveTree(GameNode p_src)
 
 Game GameTreeNodeRep::CopySubgame(void) const
 {
-  std::ostringstream os;
-  m_efg->WriteEfgFile(os, const_cast<GameTreeNodeRep *>(this));
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  return m_efg->CopySubtree(const_cast<GameTreeNodeRep *>(this), false);
 }
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
@@ -564,10 +561,96 @@ GameTreeRep::~GameTreeRep()
 
 Game GameTreeRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteEfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  return CopySubtree(m_root, true);
+}
+
+//
+// Builds a new game whose tree is a copy of the subtree rooted at
+// p_root, with the title, comment and players of this game.  The
+// information sets and outcomes of the new game are those appearing in
+// the subtree, numbered in order of first appearance, as they would be
+// if the subtree were written out and read back in.  If p_allOutcomes
+// is true, all outcomes of the game are copied instead, with their
+// current numbering.
+//
+Game GameTreeRep::CopySubtree(GameTreeNodeRep *p_root, 
+			      bool p_allOutcomes) const
+{
+  GameTreeRep *copy = new GameTreeRep;
+  copy->m_title = m_title;
+  copy->m_comment = m_comment;
+  copy->m_chance->m_label = m_chance->m_label;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = new GamePlayerRep(copy, pl);
+    player->m_label = m_players[pl]->m_label;
+    copy->m_players.Append(player);
+  }
+
+  Array<GameOutcomeRep *> outcomes(m_outcomes.Length());
+  for (int outc = 1; outc <= outcomes.Length(); outcomes[outc++] = 0);
+  if (p_allOutcomes) {
+    for (int outc = 1; outc <= outcomes.Length(); outc++) {
+      outcomes[outc] = new GameOutcomeRep(copy, outc);
+      outcomes[outc]->m_label = m_outcomes[outc]->m_label;
+      outcomes[outc]->m_payoffs = m_outcomes[outc]->m_payoffs;
+      copy->m_outcomes.Append(outcomes[outc]);
+    }
+  }
+
+  Array<Array<GameTreeInfosetRep *> > infosets(0, m_players.Length());
+  for (int pl = 0; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = (pl) ? m_players[pl] : m_chance;
+    infosets[pl] = Array<GameTreeInfosetRep *>(player->m_infosets.Length());
+    for (int iset = 1; iset <= infosets[pl].Length(); 
+	 infosets[pl][iset++] = 0);
+  }
+
+  CopyNode(copy, p_root, copy->m_root, outcomes, infosets);
+  copy->Canonicalize();
+  return copy;
+}
+
+void GameTreeRep::CopyNode(GameTreeRep *p_copy, 
+			   GameTreeNodeRep *p_src, GameTreeNodeRep *p_dest,
+			   Array<GameOutcomeRep *> &p_outcomes,
+			   Array<Array<GameTreeInfosetRep *> > &p_infosets) const
+{
+  p_dest->m_label = p_src->m_label;
+
+  if (p_src->outcome) {
+    GameOutcomeRep *&outcome = p_outcomes[p_src->outcome->m_number];
+    if (!outcome) {
+      outcome = new GameOutcomeRep(p_copy, p_copy->m_outcomes.Length() + 1);
+      outcome->m_label = p_src->outcome->m_label;
+      outcome->m_payoffs = p_src->outcome->m_payoffs;
+      p_copy->m_outcomes.Append(outcome);
+    }
+    p_dest->outcome = outcome;
+  }
+
+  if (p_src->children.Length() == 0) return;
+
+  GameTreeInfosetRep *src = p_src->infoset;
+  int pl = src->m_player->m_number;
+  GameTreeInfosetRep *&infoset = p_infosets[pl][src->m_number];
+  if (!infoset) {
+    GamePlayerRep *player = (pl) ? p_copy->m_players[pl] : p_copy->m_chance;
+    infoset = new GameTreeInfosetRep(p_copy, player->m_infosets.Length() + 1,
+				     player, src->m_actions.Length());
+    infoset->m_label = src->m_label;
+    for (int act = 1; act <= src->m_actions.Length(); act++) {
+      infoset->m_actions[act]->m_label = src->m_actions[act]->m_label;
+    }
+    infoset->m_probs = src->m_probs;
+  }
+  p_dest->infoset = infoset;
+  infoset->AddMember(p_dest);
+
+  for (int i = 1; i <= p_src->children.Length(); i++) {
+    p_dest->children.Append(new GameTreeNodeRep(p_copy, p_dest));
+    CopyNode(p_copy, p_src->children[i], p_dest->children[i],
+	     p_outcomes, p_infosets);
+  }
 }
 
 Game NewTree(void)  { return new GameTreeRep(); }
@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/gnm.h"
 #include "gambit/gtracer/gtracer.h"
 
@@ -90,13 +91,28 @@ NashGNMStrategySolver::BuildRepresentation(const Game &p_game) const
       veclength *= p_game->GetPlayer(pl)->NumStrategies();
     }
     cvector payoffs(veclength);
+
+    GameTableRep *table = dynamic_cast<GameTableRep *>(p_game.operator->());
+    if (table) {
+      // The payoff tables of a strategic game are laid out in the
+      // same order nfgame expects, so they can be copied across directly
+      int ncont = veclength / p_game->NumPlayers();
+      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	const Array<Rational> &table_payoffs = table->GetPayoffTable<Rational>(pl);
+	for (int cont = 1; cont <= ncont; cont++) {
+	  payoffs[(pl-1) * ncont + cont - 1] = 
+	    (double) (table_payoffs[cont] - minPay) * scale;
+	}
+      }
+      return new nfgame(p_game->NumPlayers(), actions, payoffs);
+    }
   
     shared_ptr<gnmgame> A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
     int *profile = new int[p_game->NumPlayers()];
-    for (StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
+    for (StrategyProfileIterator iter(p_game, true); !iter.AtEnd(); iter++) {
       for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-        profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+        profile[pl-1] = iter.GetStrategyIndex(pl) - 1;
       }
 
       for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
@@ -34,6 +34,10 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
   Thanks to the creators of the algorithms.
 */
 
+// This is the built-in implementation of Integer, which is used unless
+// Gambit is configured to use GMP instead (see integergmp.cc)
+#ifndef GAMBIT_USE_GMP
+
 #include <iostream>
 
 #include "gambit/integer.h"
@@ -94,9 +98,13 @@ long lg(unsigned long x)
 #define MALLOC_MIN_OVERHEAD 4
 #endif
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
-static IntegerRep _MinusOneRep = {1, 0, 0, {1}};
+//
+// The representation of a default-constructed Integer.  Static
+// representations are shared by every Integer which holds them, in
+// whichever thread, so they are never written to: the allocation
+// functions below always allocate a new representation in place of one.
+//
+static IntegerRep _ZeroRep = {0, 0, 1, {0}};
 
 
 // utilities to extract and transfer bits
@@ -115,6 +123,14 @@ inline static unsigned long down(unsigned long x)
   return (x >> I_SHIFT) & I_MAXNUM;
 }
 
+// shift out the low bits of a long being split into shorts; unlike
+// down(), this keeps all the high bits, however long a long is
+
+inline static unsigned long next_short(unsigned long x)
+{
+  return x >> I_SHIFT;
+}
+
 // transfer low bits to high
 
 inline static unsigned long up(unsigned long x)
@@ -198,7 +214,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
               int newlen)
 {
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     rep = Inew(newlen);
   else
     rep = old;
@@ -218,7 +234,7 @@ IntegerRep* Ialloc(IntegerRep* old, const unsigned short* src, int srclen, int n
 IntegerRep* Icalloc(IntegerRep* old, int newlen)
 {
   IntegerRep* rep;
-  if (old == 0 || newlen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(newlen);
@@ -248,7 +264,7 @@ IntegerRep* Iresize(IntegerRep* old, int newlen)
   else 
   {
     oldlen = old->len;
-    if (newlen > old->sz)
+    if (STATIC_IntegerRep(old) || newlen > old->sz)
     {
       rep = Inew(newlen);
       scpy(old->s, rep->s, oldlen);
@@ -270,11 +286,11 @@ IntegerRep* Iresize(IntegerRep* old, int newlen)
 
 IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
 {
-  if (old == src) return old; 
+  if (old == src && (old == 0 || !STATIC_IntegerRep(old))) return old; 
   IntegerRep* rep;
   if (src == 0)
   {
-    if (old == 0)
+    if (old == 0 || STATIC_IntegerRep(old))
       rep = Inew(0);
     else
     {
@@ -287,7 +303,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
   else 
   {
     int newlen = src->len;
-    if (old == 0 || newlen > old->sz)
+    if (old == 0 || STATIC_IntegerRep(old) || newlen > old->sz)
     {
       if (old != 0 && !STATIC_IntegerRep(old)) delete old;
       rep = Inew(newlen);
@@ -309,7 +325,7 @@ IntegerRep* Icopy(IntegerRep* old, const IntegerRep* src)
 IntegerRep* Icopy_long(IntegerRep* old, long x)
 {
   int newsgn = (x >= 0);
-  IntegerRep* rep = Icopy_ulong(old, newsgn ? x : -x);
+  IntegerRep* rep = Icopy_ulong(old, newsgn ? (unsigned long) x : -(unsigned long) x);
   rep->sgn = newsgn;
   return rep;
 }
@@ -322,11 +338,11 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x = next_short(x);
   }
 
   IntegerRep* rep;
-  if (old == 0 || srclen > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || srclen > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
     rep = Inew(srclen);
@@ -347,7 +363,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
 IntegerRep* Icopy_zero(IntegerRep* old)
 {
   if (old == 0 || STATIC_IntegerRep(old))
-    return &_ZeroRep;
+    old = Inew(0);
 
   old->len = 0;
   old->sgn = I_POSITIVE;
@@ -359,10 +375,10 @@ IntegerRep* Icopy_zero(IntegerRep* old)
 
 IntegerRep* Icopy_one(IntegerRep* old, int newsgn)
 {
-  if (old == 0 || 1 > old->sz)
+  if (old == 0 || STATIC_IntegerRep(old) || 1 > old->sz)
   {
     if (old != 0 && !STATIC_IntegerRep(old)) delete old;
-    return newsgn==I_NEGATIVE ? &_MinusOneRep : &_OneRep;
+    old = Inew(1);
   }
 
   old->sgn = newsgn;
@@ -579,7 +595,7 @@ int compare(const IntegerRep* x, long  y)
   else
   {
     int ysgn = y >= 0;
-    unsigned long uy = (ysgn)? y : -y;
+    unsigned long uy = (ysgn)? (unsigned long) y : -(unsigned long) y;
     int diff = xsgn - ysgn;
     if (diff == 0)
     {
@@ -591,7 +607,7 @@ int compare(const IntegerRep* x, long  y)
         while (uy != 0)
         {
           tmp[yl++] = extract(uy);
-          uy = down(uy);
+          uy = next_short(uy);
         }
         diff = xl - yl;
         if (diff == 0)
@@ -611,7 +627,7 @@ int ucompare(const IntegerRep* x, long  y)
     return xl;
   else
   {
-    unsigned long uy = (y >= 0)? y : -y;
+    unsigned long uy = (y >= 0)? (unsigned long) y : -(unsigned long) y;
     int diff = xl - SHORT_PER_LONG;
     if (diff <= 0)
     {
@@ -620,7 +636,7 @@ int ucompare(const IntegerRep* x, long  y)
       while (uy != 0)
       {
         tmp[yl++] = extract(uy);
-        uy = down(uy);
+        uy = next_short(uy);
       }
       diff = xl - yl;
       if (diff == 0)
@@ -761,7 +777,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
   int xrsame = x == r;
 
   int ysgn = (y >= 0);
-  unsigned long uy = (ysgn)? y : -y;
+  unsigned long uy = (ysgn)? (unsigned long) y : -(unsigned long) y;
 
   if (y == 0)
     r = Ialloc(r, x->s, xl, xsgn, xl);
@@ -781,11 +797,18 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (as < topa && uy != 0)
     {
       unsigned long u = extract(uy);
-      uy = down(uy);
+      uy = next_short(uy);
       sum += (unsigned long)(*as++) + u;
       *rs++ = extract(sum);
       sum = down(sum);
     }
+    while (uy != 0)             // y is longer than x
+    {
+      sum += extract(uy);
+      uy = next_short(uy);
+      *rs++ = extract(sum);
+      sum = down(sum);
+    }
     while (sum != 0 && as < topa)
     {
       sum += (unsigned long)(*as++);
@@ -805,7 +828,7 @@ IntegerRep* add(const IntegerRep* x, int negatex, long y, IntegerRep* r)
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy = next_short(uy);
     }
     int comp = xl - yl;
     if (comp == 0)
@@ -1027,13 +1050,13 @@ IntegerRep* multiply(const IntegerRep* x, long y, IntegerRep* r)
   {
     int ysgn = y >= 0;
     int rsgn = x->sgn == ysgn;
-    unsigned long uy = (ysgn)? y : -y;
+    unsigned long uy = (ysgn)? (unsigned long) y : -(unsigned long) y;
     unsigned short tmp[SHORT_PER_LONG];
     int yl = 0;
     while (uy != 0)
     {
       tmp[yl++] = extract(uy);
-      uy = down(uy);
+      uy = next_short(uy);
     }
 
     int rl = xl + yl;
@@ -1291,12 +1314,12 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
   if (ysgn)
     u = y;
   else
-    u = -y;
+    u = -(unsigned long) y;
   int yl = 0;
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u = next_short(u);
   }
 
   int comp = xl - yl;
@@ -1322,10 +1345,13 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1362,12 +1388,12 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
   if (ysgn)
     u = y;
   else
-    u = -y;
+    u = -(unsigned long) y;
   int yl = 0;
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u = next_short(u);
   }
 
   int comp = xl - yl;
@@ -1397,10 +1423,13 @@ void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1497,6 +1526,7 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
       Icheck(r);
       unscale(r->s, r->len, prescale, r->s);
     }
+    r->sgn = xsgn;
   }
   q->sgn = samesign;
   Icheck(q);
@@ -1555,6 +1585,9 @@ IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
       Icheck(r);
       unscale(r->s, r->len, prescale, r->s);
     }
+    // the remainder takes the sign of the dividend, as in the
+    // single-digit case above
+    r->sgn = xsgn;
   }
   Icheck(r);
   return r;
@@ -1573,12 +1606,12 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
   if (ysgn)
     u = y;
   else
-    u = -y;
+    u = -(unsigned long) y;
   int yl = 0;
   while (u != 0)
   {
     ys[yl++] = extract(u);
-    u = down(u);
+    u = next_short(u);
   }
 
   int comp = xl - yl;
@@ -1602,10 +1635,13 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
 	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
     if (prescale != 1)
     {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
+      unsigned long prod = 0;
+      for (int i = 0; i < yl; i++)
+      {
+        prod += (unsigned long)prescale * (unsigned long)ys[i];
+        ys[i] = extract(prod);
+        prod = down(prod);
+      }
       r = multiply(x, ((long)prescale & I_MAXNUM), r);
     }
     else
@@ -1621,6 +1657,9 @@ IntegerRep* mod(const IntegerRep* x, long y, IntegerRep* r)
       Icheck(r);
       unscale(r->s, r->len, prescale, r->s);
     }
+    // the remainder takes the sign of the dividend, as in the
+    // single-digit case above
+    r->sgn = xsgn;
   }
   Icheck(r);
   return r;
@@ -1769,13 +1808,13 @@ IntegerRep* bitop(const IntegerRep* x, long y, IntegerRep* r, char op)
   if (newsgn)
 	 u = y;
   else
-	 u = -y;
+	 u = -(unsigned long) y;
 
   int l = 0;
   while (u != 0)
   {
 	 tmp[l++] = extract(u);
-	 u = down(u);
+	 u = next_short(u);
   }
 
   int xl = x->len;
@@ -1857,7 +1896,7 @@ void (setbit)(Integer& x, long b)
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
     int xl = x.rep ? x.rep->len : 0;
-    if (xl <= bw)
+    if (xl <= bw || STATIC_IntegerRep(x.rep))
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
@@ -1869,9 +1908,11 @@ void clearbit(Integer& x, long b)
   if (b >= 0)
     {
       if (x.rep == 0)
-	x.rep = &_ZeroRep;
+	x.rep = Icopy_zero(x.rep);
       else
 	{
+	  if (STATIC_IntegerRep(x.rep))
+	    x.rep = Icopy(x.rep, x.rep);
 	  int bw = (int) ((unsigned long)b / I_SHIFT);
 	  int sw = (int) ((unsigned long)b % I_SHIFT);
 	  if (x.rep->len > bw)
@@ -2053,7 +2094,7 @@ IntegerRep* power(const IntegerRep* x, long y, IntegerRep* r)
 IntegerRep* abs(const IntegerRep* src, IntegerRep* dest)
 {
   nonnil(src);
-  if (src != dest)
+  if (src != dest || STATIC_IntegerRep(dest))
     dest = Icopy(dest, src);
   dest->sgn = I_POSITIVE;
   return dest;
@@ -2062,7 +2103,7 @@ IntegerRep* abs(const IntegerRep* src, IntegerRep* dest)
 IntegerRep* negate(const IntegerRep* src, IntegerRep* dest)
 {
   nonnil(src);
-  if (src != dest)
+  if (src != dest || STATIC_IntegerRep(dest))
     dest = Icopy(dest, src);
   if (dest->len != 0) 
     dest->sgn = !dest->sgn;
@@ -2471,7 +2512,13 @@ void  add(const Integer& x, long y, Integer& dest)
 
 void  sub(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, -y, dest.rep);
+  if (y == LONG_MIN)
+  {
+    Integer iy(y);
+    dest.rep = add(x.rep, 0, iy.rep, 1, dest.rep);
+  }
+  else
+    dest.rep = add(x.rep, 0, -y, dest.rep);
 }
 
 void  mul(const Integer& x, long y, Integer& dest)
@@ -2901,3 +2948,5 @@ Integer &Integer::operator%=(long y)
 }
 
 }
+
+#endif  // GAMBIT_USE_GMP
@@ -0,0 +1,805 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/integergmp.cc
+// Implementation of an arbitrary-length integer class using GMP
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+//
+// This implementation of Integer is used in place of the one in integer.cc
+// when Gambit is configured with --with-gmp.  The interface is unchanged:
+// the representation pointer of an Integer refers to a GMP integer (mpz_t)
+// instead of an IntegerRep.  A null pointer represents zero, so that
+// default-constructed Integers do not allocate.
+//
+// The conversions to floating point reproduce those of integer.cc
+// bit for bit, so that results do not depend on the choice of
+// implementation.
+//
+
+#ifdef GAMBIT_USE_GMP
+
+#include <iostream>
+#include <cctype>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <gmp.h>
+
+#include "gambit/gambit.h"
+#include "gambit/integer.h"
+
+namespace Gambit {
+
+namespace {
+
+/// The GMP integer zero, represented by a null rep.  This is
+/// initialized statically, so that it may be used safely from
+/// several threads.
+mp_limb_t zeroLimb = 0;
+const __mpz_struct zeroInteger = { 1, 0, &zeroLimb };
+
+/// Returns the GMP integer represented by rep, for reading
+inline mpz_srcptr Src(const IntegerRep *rep)
+{
+  return (rep) ? reinterpret_cast<mpz_srcptr>(rep) : &zeroInteger;
+}
+
+/// Returns the GMP integer represented by rep, for writing, allocating
+/// it if rep represents zero
+inline mpz_ptr Dst(IntegerRep *&rep)
+{
+  if (!rep) {
+    mpz_ptr z = new __mpz_struct;
+    mpz_init(z);
+    rep = reinterpret_cast<IntegerRep *>(z);
+  }
+  return reinterpret_cast<mpz_ptr>(rep);
+}
+
+/// Absolute value of a long, as an unsigned long
+inline unsigned long Magnitude(long y)
+{ return (y >= 0) ? (unsigned long) y : 0UL - (unsigned long) y; }
+
+} // end anonymous namespace
+
+//--------------------------------------------------------------------------
+//                   Conversions used by inline members
+//--------------------------------------------------------------------------
+
+// Returns LONG_MAX or LONG_MIN if the value does not fit
+long Itolong(const IntegerRep *rep)
+{
+  mpz_srcptr x = Src(rep);
+  if (mpz_fits_slong_p(x)) {
+    return mpz_get_si(x);
+  }
+  return (mpz_sgn(x) > 0) ? LONG_MAX : LONG_MIN;
+}
+
+int Iislong(const IntegerRep *rep)
+{
+  return mpz_fits_slong_p(Src(rep));
+}
+
+// The conversion accumulates the bits from the most significant
+// down, as integer.cc does
+double Itodouble(const IntegerRep *rep)
+{
+  mpz_t a;
+  mpz_init(a);
+  mpz_abs(a, Src(rep));
+  double d = 0.0;
+  double bound = DBL_MAX / 2.0;
+  for (long b = (long) mpz_sizeinbase(a, 2) - 1; b >= 0; b--) {
+    if (d >= bound) {
+      mpz_clear(a);
+      return (mpz_sgn(Src(rep)) < 0) ? -HUGE_VAL : HUGE_VAL;
+    }
+    d *= 2.0;
+    if (mpz_tstbit(a, b)) d += 1.0;
+  }
+  mpz_clear(a);
+  return (mpz_sgn(Src(rep)) < 0) ? -d : d;
+}
+
+int Iisdouble(const IntegerRep *rep)
+{
+  mpz_t a;
+  mpz_init(a);
+  mpz_abs(a, Src(rep));
+  double d = 0.0;
+  double bound = DBL_MAX / 2.0;
+  for (long b = (long) mpz_sizeinbase(a, 2) - 1; b >= 0; b--) {
+    int bit = mpz_tstbit(a, b);
+    // integer.cc checks whether any less significant 16-bit limbs remain
+    if (d > bound || (d == bound && (b >= 16 || bit))) {
+      mpz_clear(a);
+      return 0;
+    }
+    d *= 2.0;
+    if (bit) d += 1.0;
+  }
+  mpz_clear(a);
+  return 1;
+}
+
+//--------------------------------------------------------------------------
+//                             Lifecycle
+//--------------------------------------------------------------------------
+
+Integer::Integer() : rep(0) { }
+
+Integer::Integer(IntegerRep *r) : rep(r) { }
+
+Integer::Integer(int y) : rep(0)
+{ if (y != 0) mpz_set_si(Dst(rep), y); }
+
+Integer::Integer(long y) : rep(0)
+{ if (y != 0) mpz_set_si(Dst(rep), y); }
+
+Integer::Integer(unsigned long y) : rep(0)
+{ if (y != 0) mpz_set_ui(Dst(rep), y); }
+
+Integer::Integer(const Integer &y) : rep(0)
+{ if (y.rep) mpz_set(Dst(rep), Src(y.rep)); }
+
+Integer::~Integer()
+{
+  if (rep) {
+    mpz_clear(reinterpret_cast<mpz_ptr>(rep));
+    delete reinterpret_cast<mpz_ptr>(rep);
+  }
+}
+
+Integer &Integer::operator=(const Integer &y)
+{
+  if (this != &y && (rep || y.rep)) {
+    mpz_set(Dst(rep), Src(y.rep));
+  }
+  return *this;
+}
+
+Integer &Integer::operator=(long y)
+{
+  if (rep || y != 0) {
+    mpz_set_si(Dst(rep), y);
+  }
+  return *this;
+}
+
+int Integer::initialized() const
+{
+  return 1;
+}
+
+int Integer::OK() const
+{
+  return 1;
+}
+
+void Integer::error(const char *) const
+{ }
+
+//--------------------------------------------------------------------------
+//                        Procedural versions
+//--------------------------------------------------------------------------
+
+int compare(const Integer &x, const Integer &y)
+{
+  return mpz_cmp(Src(x.rep), Src(y.rep));
+}
+
+int ucompare(const Integer &x, const Integer &y)
+{
+  return mpz_cmpabs(Src(x.rep), Src(y.rep));
+}
+
+int compare(const Integer &x, long y)
+{
+  return mpz_cmp_si(Src(x.rep), y);
+}
+
+int ucompare(const Integer &x, long y)
+{
+  return mpz_cmpabs_ui(Src(x.rep), Magnitude(y));
+}
+
+int compare(long x, const Integer &y)
+{
+  return -compare(y, x);
+}
+
+int ucompare(long x, const Integer &y)
+{
+  return -ucompare(y, x);
+}
+
+void add(const Integer &x, const Integer &y, Integer &dest)
+{
+  mpz_add(Dst(dest.rep), Src(x.rep), Src(y.rep));
+}
+
+void sub(const Integer &x, const Integer &y, Integer &dest)
+{
+  mpz_sub(Dst(dest.rep), Src(x.rep), Src(y.rep));
+}
+
+void mul(const Integer &x, const Integer &y, Integer &dest)
+{
+  mpz_mul(Dst(dest.rep), Src(x.rep), Src(y.rep));
+}
+
+void div(const Integer &x, const Integer &y, Integer &dest)
+{
+  if (mpz_sgn(Src(y.rep)) == 0) {
+    throw ZeroDivideException();
+  }
+  mpz_tdiv_q(Dst(dest.rep), Src(x.rep), Src(y.rep));
+}
+
+void mod(const Integer &x, const Integer &y, Integer &dest)
+{
+  if (mpz_sgn(Src(y.rep)) == 0) {
+    throw ZeroDivideException();
+  }
+  mpz_tdiv_r(Dst(dest.rep), Src(x.rep), Src(y.rep));
+}
+
+void divide(const Integer &x, const Integer &y, Integer &q, Integer &r)
+{
+  if (mpz_sgn(Src(y.rep)) == 0) {
+    throw ZeroDivideException();
+  }
+  mpz_tdiv_qr(Dst(q.rep), Dst(r.rep), Src(x.rep), Src(y.rep));
+}
+
+void lshift(const Integer &x, const Integer &y, Integer &dest)
+{
+  lshift(x, Itolong(y.rep), dest);
+}
+
+void rshift(const Integer &x, const Integer &y, Integer &dest)
+{
+  lshift(x, -Itolong(y.rep), dest);
+}
+
+void pow(const Integer &x, const Integer &y, Integer &dest)
+{
+  pow(x, Itolong(y.rep), dest);
+}
+
+void add(const Integer &x, long y, Integer &dest)
+{
+  if (y >= 0) {
+    mpz_add_ui(Dst(dest.rep), Src(x.rep), (unsigned long) y);
+  }
+  else {
+    mpz_sub_ui(Dst(dest.rep), Src(x.rep), Magnitude(y));
+  }
+}
+
+void sub(const Integer &x, long y, Integer &dest)
+{
+  if (y >= 0) {
+    mpz_sub_ui(Dst(dest.rep), Src(x.rep), (unsigned long) y);
+  }
+  else {
+    mpz_add_ui(Dst(dest.rep), Src(x.rep), Magnitude(y));
+  }
+}
+
+void mul(const Integer &x, long y, Integer &dest)
+{
+  mpz_mul_si(Dst(dest.rep), Src(x.rep), y);
+}
+
+void div(const Integer &x, long y, Integer &dest)
+{
+  if (y == 0) {
+    throw ZeroDivideException();
+  }
+  mpz_ptr q = Dst(dest.rep);
+  mpz_tdiv_q_ui(q, Src(x.rep), Magnitude(y));
+  if (y < 0) mpz_neg(q, q);
+}
+
+void mod(const Integer &x, long y, Integer &dest)
+{
+  if (y == 0) {
+    throw ZeroDivideException();
+  }
+  mpz_tdiv_r_ui(Dst(dest.rep), Src(x.rep), Magnitude(y));
+}
+
+void divide(const Integer &x, long y, Integer &q, long &rem)
+{
+  if (y == 0) {
+    throw ZeroDivideException();
+  }
+  int xsgn = mpz_sgn(Src(x.rep));
+  mpz_ptr qq = Dst(q.rep);
+  unsigned long r = mpz_tdiv_q_ui(qq, Src(x.rep), Magnitude(y));
+  if (y < 0) mpz_neg(qq, qq);
+  rem = (xsgn < 0) ? -(long) r : (long) r;
+}
+
+// As in integer.cc, shifts act on the absolute value
+void lshift(const Integer &x, long y, Integer &dest)
+{
+  if (y >= 0) {
+    mpz_mul_2exp(Dst(dest.rep), Src(x.rep), (unsigned long) y);
+  }
+  else {
+    mpz_tdiv_q_2exp(Dst(dest.rep), Src(x.rep), Magnitude(y));
+  }
+}
+
+void rshift(const Integer &x, long y, Integer &dest)
+{
+  lshift(x, -y, dest);
+}
+
+void pow(const Integer &x, long y, Integer &dest)
+{
+  mpz_srcptr b = Src(x.rep);
+  int negative = mpz_sgn(b) < 0 && (y & 1);
+  if (y == 0 || mpz_cmpabs_ui(b, 1) == 0) {
+    mpz_set_si(Dst(dest.rep), (negative) ? -1 : 1);
+  }
+  else if (mpz_sgn(b) == 0 || y < 0) {
+    mpz_set_ui(Dst(dest.rep), 0);
+  }
+  else {
+    mpz_pow_ui(Dst(dest.rep), b, (unsigned long) y);
+  }
+}
+
+void abs(const Integer &x, Integer &dest)
+{
+  if (x.rep || dest.rep) {
+    mpz_abs(Dst(dest.rep), Src(x.rep));
+  }
+}
+
+void negate(const Integer &x, Integer &dest)
+{
+  if (x.rep || dest.rep) {
+    mpz_neg(Dst(dest.rep), Src(x.rep));
+  }
+}
+
+// As in integer.cc, complements the bits of the absolute value up
+// to the most significant one, leaving the sign unchanged
+void complement(const Integer &x, Integer &dest)
+{
+  mpz_srcptr src = Src(x.rep);
+  int sgn = mpz_sgn(src);
+  if (sgn == 0) {
+    dest = 0L;
+    return;
+  }
+  mpz_t mask;
+  mpz_init(mask);
+  mpz_setbit(mask, mpz_sizeinbase(src, 2));
+  mpz_sub_ui(mask, mask, 1);
+  mpz_ptr r = Dst(dest.rep);
+  mpz_abs(r, src);
+  mpz_xor(r, r, mask);
+  if (sgn < 0) mpz_neg(r, r);
+  mpz_clear(mask);
+}
+
+void add(long x, const Integer &y, Integer &dest)
+{
+  add(y, x, dest);
+}
+
+void sub(long x, const Integer &y, Integer &dest)
+{
+  sub(y, x, dest);
+  dest.negate();
+}
+
+void mul(long x, const Integer &y, Integer &dest)
+{
+  mul(y, x, dest);
+}
+
+//--------------------------------------------------------------------------
+//                    Builtin functions which are friends
+//--------------------------------------------------------------------------
+
+long lg(const Integer &x)
+{
+  mpz_srcptr a = Src(x.rep);
+  return (mpz_sgn(a) == 0) ? 0 : (long) mpz_sizeinbase(a, 2) - 1;
+}
+
+// Real division of num / den, computed in the same way as integer.cc
+double ratio(const Integer &num, const Integer &den)
+{
+  Integer q, r;
+  divide(num, den, q, r);
+  double d1 = q.as_double();
+
+  if (d1 >= DBL_MAX || d1 <= -DBL_MAX || sign(r) == 0) {
+    return d1;
+  }
+
+  // use as much precision as available for fractional part
+  mpz_t a, b;
+  mpz_init(a);
+  mpz_init(b);
+  mpz_abs(a, Src(den.rep));
+  mpz_abs(b, Src(r.rep));
+  double d2 = 0.0, d3 = 0.0;
+  for (long i = (long) mpz_sizeinbase(a, 2) - 1; i >= 0; i--) {
+    if (d2 + 1.0 == d2) break;   // out of precision when we get here
+    d2 *= 2.0;
+    if (mpz_tstbit(a, i)) d2 += 1.0;
+    d3 *= 2.0;
+    if (mpz_tstbit(b, i)) d3 += 1.0;
+  }
+  mpz_clear(a);
+  mpz_clear(b);
+
+  if (sign(r) < 0) d3 = -d3;
+  return d1 + d3 / d2;
+}
+
+Integer gcd(const Integer &x, const Integer &y)
+{
+  Integer r;
+  if (x.rep || y.rep) {
+    mpz_gcd(Dst(r.rep), Src(x.rep), Src(y.rep));
+  }
+  return r;
+}
+
+int even(const Integer &y)
+{
+  return mpz_even_p(Src(y.rep));
+}
+
+int odd(const Integer &y)
+{
+  return mpz_odd_p(Src(y.rep));
+}
+
+int sign(const Integer &x)
+{
+  return mpz_sgn(Src(x.rep));
+}
+
+// As in integer.cc, bit operations act on the absolute value
+void setbit(Integer &x, long b)
+{
+  if (b >= 0) {
+    mpz_ptr z = Dst(x.rep);
+    int negative = mpz_sgn(z) < 0;
+    mpz_abs(z, z);
+    mpz_setbit(z, b);
+    if (negative) mpz_neg(z, z);
+  }
+}
+
+void clearbit(Integer &x, long b)
+{
+  if (b >= 0 && x.rep) {
+    mpz_ptr z = Dst(x.rep);
+    int negative = mpz_sgn(z) < 0;
+    mpz_abs(z, z);
+    mpz_clrbit(z, b);
+    if (negative) mpz_neg(z, z);
+  }
+}
+
+int testbit(const Integer &x, long b)
+{
+  if (b < 0 || !x.rep) {
+    return 0;
+  }
+  mpz_t a;
+  mpz_init(a);
+  mpz_abs(a, Src(x.rep));
+  int bit = mpz_tstbit(a, b);
+  mpz_clear(a);
+  return bit;
+}
+
+//--------------------------------------------------------------------------
+//                         Textual representation
+//--------------------------------------------------------------------------
+
+std::string Itoa(const Integer &x, int base, int width)
+{
+  // Negative bases give upper-case digits, as integer.cc does
+  char *digits = mpz_get_str(0, -base, Src(x.rep));
+  std::string s(digits);
+  void (*freefunc)(void *, size_t);
+  mp_get_memory_functions(0, 0, &freefunc);
+  freefunc(digits, s.length() + 1);
+  if ((int) s.length() < width) {
+    s.insert((std::string::size_type) 0, width - s.length(), ' ');
+  }
+  return s;
+}
+
+Integer atoI(const char *s, int base)
+{
+  Integer r;
+  if (s == 0) {
+    return r;
+  }
+  while (isspace(*s)) ++s;
+  bool negative = false;
+  if (*s == '-') {
+    negative = true;
+    s++;
+  }
+  else if (*s == '+') {
+    s++;
+  }
+  for (;;) {
+    long digit;
+    if (*s >= '0' && *s <= '9') digit = *s - '0';
+    else if (*s >= 'a' && *s <= 'z') digit = *s - 'a' + 10;
+    else if (*s >= 'A' && *s <= 'Z') digit = *s - 'A' + 10;
+    else break;
+    if (digit >= base) break;
+    r *= base;
+    r += digit;
+    ++s;
+  }
+  if (negative) r.negate();
+  return r;
+}
+
+std::ostream &operator<<(std::ostream &s, const Integer &y)
+{
+  return s << Itoa(y, 10, 0);
+}
+
+std::istream &operator>>(std::istream &s, Integer &y)
+{
+  char sgn = 0;
+  char ch;
+  y = 0L;
+
+  do  {
+    s.get(ch);
+  }  while (isspace(ch));
+
+  s.unget();
+
+  while (s.get(ch)) {
+    if (ch == '-') {
+      if (sgn == 0)
+	sgn = '-';
+      else
+	break;
+    }
+    else {
+      if (ch >= '0' && ch <= '9') {
+	long digit = ch - '0';
+	y *= 10;
+	y += digit;
+      }
+      else
+	break;
+    }
+  }
+  s.unget();
+
+  if (sgn == '-')
+    y.negate();
+
+  return s;
+}
+
+//--------------------------------------------------------------------------
+//                      Operators and other functions
+//--------------------------------------------------------------------------
+
+bool Integer::operator==(const Integer &y) const
+{ return compare(*this, y) == 0; }
+
+bool Integer::operator==(long y) const
+{ return compare(*this, y) == 0; }
+
+bool Integer::operator!=(const Integer &y) const
+{ return compare(*this, y) != 0; }
+
+bool Integer::operator!=(long y) const
+{ return compare(*this, y) != 0; }
+
+bool Integer::operator<(const Integer &y) const
+{ return compare(*this, y) < 0; }
+
+bool Integer::operator<(long y) const
+{ return compare(*this, y) < 0; }
+
+bool Integer::operator<=(const Integer &y) const
+{ return compare(*this, y) <= 0; }
+
+bool Integer::operator<=(long y) const
+{ return compare(*this, y) <= 0; }
+
+bool Integer::operator>(const Integer &y) const
+{ return compare(*this, y) > 0; }
+
+bool Integer::operator>(long y) const
+{ return compare(*this, y) > 0; }
+
+bool Integer::operator>=(const Integer &y) const
+{ return compare(*this, y) >= 0; }
+
+bool Integer::operator>=(long y) const
+{ return compare(*this, y) >= 0; }
+
+Integer &Integer::operator+=(const Integer &y)
+{ add(*this, y, *this); return *this; }
+
+Integer &Integer::operator+=(long y)
+{ add(*this, y, *this); return *this; }
+
+void Integer::operator++()
+{ add(*this, 1L, *this); }
+
+Integer &Integer::operator-=(const Integer &y)
+{ sub(*this, y, *this); return *this; }
+
+Integer &Integer::operator-=(long y)
+{ sub(*this, y, *this); return *this; }
+
+void Integer::operator--()
+{ add(*this, -1L, *this); }
+
+Integer &Integer::operator*=(const Integer &y)
+{ mul(*this, y, *this); return *this; }
+
+Integer &Integer::operator*=(long y)
+{ mul(*this, y, *this); return *this; }
+
+Integer &Integer::operator/=(const Integer &y)
+{ div(*this, y, *this); return *this; }
+
+Integer &Integer::operator/=(long y)
+{ div(*this, y, *this); return *this; }
+
+Integer &Integer::operator%=(const Integer &y)
+{ mod(*this, y, *this); return *this; }
+
+Integer &Integer::operator%=(long y)
+{ mod(*this, y, *this); return *this; }
+
+Integer &Integer::operator<<=(const Integer &y)
+{ lshift(*this, y, *this); return *this; }
+
+Integer &Integer::operator<<=(long y)
+{ lshift(*this, y, *this); return *this; }
+
+Integer &Integer::operator>>=(const Integer &y)
+{ rshift(*this, y, *this); return *this; }
+
+Integer &Integer::operator>>=(long y)
+{ rshift(*this, y, *this); return *this; }
+
+void Integer::abs()
+{ Gambit::abs(*this, *this); }
+
+void Integer::negate()
+{ Gambit::negate(*this, *this); }
+
+Integer Integer::operator-(void) const
+{ Integer r; Gambit::negate(*this, r); return r; }
+
+Integer Integer::operator+(const Integer &y) const
+{ Integer r; add(*this, y, r); return r; }
+
+Integer Integer::operator+(long y) const
+{ Integer r; add(*this, y, r); return r; }
+
+Integer Integer::operator-(const Integer &y) const
+{ Integer r; sub(*this, y, r); return r; }
+
+Integer Integer::operator-(long y) const
+{ Integer r; sub(*this, y, r); return r; }
+
+Integer Integer::operator*(const Integer &y) const
+{ Integer r; mul(*this, y, r); return r; }
+
+Integer Integer::operator*(long y) const
+{ Integer r; mul(*this, y, r); return r; }
+
+Integer Integer::operator/(const Integer &y) const
+{ Integer r; div(*this, y, r); return r; }
+
+Integer Integer::operator/(long y) const
+{ Integer r; div(*this, y, r); return r; }
+
+Integer Integer::operator%(const Integer &y) const
+{ Integer r; mod(*this, y, r); return r; }
+
+Integer Integer::operator%(long y) const
+{ Integer r; mod(*this, y, r); return r; }
+
+Integer Integer::operator<<(const Integer &y) const
+{ Integer r; lshift(*this, y, r); return r; }
+
+Integer Integer::operator<<(long y) const
+{ Integer r; lshift(*this, y, r); return r; }
+
+Integer Integer::operator>>(const Integer &y) const
+{ Integer r; rshift(*this, y, r); return r; }
+
+Integer Integer::operator>>(long y) const
+{ Integer r; rshift(*this, y, r); return r; }
+
+Integer abs(const Integer &x)
+{ Integer r; abs(x, r); return r; }
+
+Integer sqr(const Integer &x)
+{ Integer r; mul(x, x, r); return r; }
+
+Integer pow(const Integer &x, long y)
+{ Integer r; pow(x, y, r); return r; }
+
+Integer pow(const Integer &x, const Integer &y)
+{ Integer r; pow(x, y, r); return r; }
+
+Integer Ipow(long x, long y)
+{ Integer r(x); pow(r, y, r); return r; }
+
+Integer sqrt(const Integer &x)
+{
+  Integer r;
+  if (sign(x) < 0) {
+    x.error("Attempted square root of negative Integer");
+  }
+  else if (sign(x) > 0) {
+    r = x;
+    r >>= (lg(x) / 2); // get close
+    Integer q;
+    div(x, r, q);
+    while (q < r) {
+      r += q;
+      r >>= 1;
+      div(x, r, q);
+    }
+  }
+  return r;
+}
+
+Integer lcm(const Integer &x, const Integer &y)
+{
+  Integer r;
+  Integer g;
+  if (sign(x) == 0 || sign(y) == 0)
+    g = 1L;
+  else
+    g = gcd(x, y);
+  div(x, g, r);
+  mul(r, y, r);
+  return r;
+}
+
+}  // end namespace Gambit
+
+#endif  // GAMBIT_USE_GMP
@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/ipa.h"
 #include "gambit/gtracer/gtracer.h"
 
@@ -61,17 +62,32 @@ NashIPAStrategySolver::Solve(const Game &p_game,
       veclength *= p_game->GetPlayer(pl)->NumStrategies();
     }
     cvector payoffs(veclength);
-  
-    A = new nfgame(p_game->NumPlayers(), actions, payoffs);
-  
-    int *profile = new int[p_game->NumPlayers()];
-    for (StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
+
+    GameTableRep *table = dynamic_cast<GameTableRep *>(p_game.operator->());
+    if (table) {
+      // The payoff tables of a strategic game are laid out in the
+      // same order nfgame expects, so they can be copied across directly
+      int ncont = veclength / p_game->NumPlayers();
       for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-	profile[pl-1] = (*iter)->GetStrategy(pl)->GetNumber() - 1;
+	const Array<double> &table_payoffs = table->GetPayoffTable<double>(pl);
+	for (int cont = 1; cont <= ncont; cont++) {
+	  payoffs[(pl-1) * ncont + cont - 1] = table_payoffs[cont];
+	}
       }
+      A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+    }
+    else {
+      A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+  
+      int *profile = new int[p_game->NumPlayers()];
+      for (StrategyProfileIterator iter(p_game, true); !iter.AtEnd(); iter++) {
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  profile[pl-1] = iter.GetStrategyIndex(pl) - 1;
+	}
 
-      for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
-	A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
+	for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+	  A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
+	}
       }
     }
   }
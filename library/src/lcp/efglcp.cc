@@ -38,7 +38,7 @@ public:
   Rational maxpay;
   T eps;
   List<GameInfoset> isets1, isets2;
-  List<Gambit::linalg::BFS<T> > m_list;
+  Gambit::linalg::BFSSet<T> m_list;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
   bool AddBFS(const linalg::LemkeTableau<T> &);
@@ -59,13 +59,7 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tablea
     }
   }
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
-  }
-  else {
-    return false;
-  }
+  return m_list.insert(cbfs);
 }
 
 //
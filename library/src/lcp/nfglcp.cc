@@ -23,6 +23,12 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#ifdef GAMBIT_THREADS
+#include <pthread.h>
+#endif  // GAMBIT_THREADS
 
 #include "gambit/gambit.h"
 #include "gambit/linalg/lhtab.h"
@@ -112,21 +118,92 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
+#ifdef GAMBIT_THREADS
+//
+// A copy of a tableau in floating point refers to the factorization of
+// the basis in the original, until it is refactored.  Copies which are
+// to be pivoted in another thread are refactored at once, so that they
+// do not depend on the original.  Tableaux in rationals are independent
+// of the original when copied.
+//
+template <class T> void Detach(linalg::LHTableau<T> &p_tableau);
+
+template<> void Detach(linalg::LHTableau<double> &p_tableau)
+{ p_tableau.Refactor(); }
+
+template<> void Detach(linalg::LHTableau<Rational> &)
+{ }
+#endif  // GAMBIT_THREADS
+
+//
+// The tableau in floating point for the game, with the matrices it
+// refers to
+//
+class FloatTableau {
+public:
+  Matrix<double> m_A1, m_A2;
+  Vector<double> m_b1, m_b2;
+  linalg::LHTableau<double> m_tableau;
+
+  FloatTableau(const Game &p_game)
+    : m_A1(Make_A1<double>(p_game)), m_A2(Make_A2<double>(p_game)),
+      m_b1(Make_b1<double>(p_game)), m_b2(Make_b2<double>(p_game)),
+      m_tableau(m_A1, m_A2, m_b1, m_b2) { }
+};
+
 }  // end anonymous namespace
   
 
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
 public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
+  Gambit::linalg::BFSSet<T> m_bfsList;
   List<MixedStrategyProfile<T> > m_equilibria;
+  // The tableau in floating point at the extraneous solution, from which
+  // paths are followed before they are certified, if they are
+  const linalg::LHTableau<double> *m_floatTableau;
+
+#ifdef GAMBIT_THREADS
+  pthread_mutex_t m_mutex;
+
+  Solution(void) : m_floatTableau(0) { pthread_mutex_init(&m_mutex, 0); }
+  ~Solution() { pthread_mutex_destroy(&m_mutex); }
+#else
+  Solution(void) : m_floatTableau(0) { }
+#endif  // GAMBIT_THREADS
+
+  // Holds the lock on the solution, when threads are used, while in scope
+  class Lock {
+  public:
+#ifdef GAMBIT_THREADS
+    Lock(Solution &p_solution) : m_mutex(p_solution.m_mutex)
+    { pthread_mutex_lock(&m_mutex); }
+    ~Lock() { pthread_mutex_unlock(&m_mutex); }
+
+  private:
+    pthread_mutex_t &m_mutex;
+#else
+    Lock(Solution &) { }
+#endif  // GAMBIT_THREADS
+  };
 
   bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
   { return m_bfsList.Contains(p_bfs); }
   void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  { m_bfsList.insert(p_bfs); }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
+
+  // Copies of a tableau in floating point update the original, so they
+  // are made one at a time, and refactored so that they do not depend
+  // on it afterwards
+  linalg::LHTableau<double> CopyFloatTableau(void)
+  {
+    Lock lock(*this);
+    linalg::LHTableau<double> tableau(*m_floatTableau);
+    tableau.Refactor();
+    return tableau;
+  }
 };
   
 //
@@ -142,6 +219,11 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 				Solution &p_solution) const
 {
   Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
+  typename Solution::Lock lock(p_solution);
+  if (m_stopAfter > 0 && p_solution.EquilibriumCount() >= m_stopAfter) {
+    // Another thread has already found the last equilibrium sought
+    throw EquilibriumLimitReached();
+  }
   if (p_solution.Contains(cbfs)) {
     return false;
   }
@@ -195,6 +277,92 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
   return true;
 }
 
+//
+// FollowPath follows the path for the label from the CBFS at the
+// tableau.  The path is abandoned, returning zero, once p_abandon
+// returns true, if given.
+//
+template <class T> int
+NashLcpStrategySolver<T>::FollowPath(linalg::LHTableau<T> &p_tableau,
+				     int p_label, Solution &,
+				     bool (*p_abandon)(void *),
+				     void *p_data) const
+{
+  return p_tableau.LemkePath(p_label, p_abandon, p_data);
+}
+
+namespace {
+
+//
+// A path in floating point which has made this many pivots per row of
+// the tableau is taken to be cycling
+//
+const long FLOAT_PATH_PIVOTS = 50;
+
+class FloatPath {
+public:
+  bool (*m_abandon)(void *);
+  void *m_data;
+  long m_pivots, m_maxPivots;
+
+  static bool Abandon(void *p_path)
+  {
+    FloatPath *path = static_cast<FloatPath *>(p_path);
+    return (++path->m_pivots > path->m_maxPivots ||
+	    (path->m_abandon && path->m_abandon(path->m_data)));
+  }
+};
+
+}  // end anonymous namespace
+
+//
+// When certifying, the path is first followed in floating point, from
+// the same basis, on a copy of the tableau in floating point.  The exact
+// tableau is then pivoted to the basis at the end of that path.  If that
+// basis is feasible and complementary, it is an exact equilibrium, and
+// the tableau is left there.  Otherwise, as when the path in floating
+// point appears to cycle, the path is followed exactly.
+//
+template<> int
+NashLcpStrategySolver<Rational>::FollowPath(linalg::LHTableau<Rational> &p_tableau,
+					    int p_label, Solution &p_solution,
+					    bool (*p_abandon)(void *),
+					    void *p_data) const
+{
+  if (!p_solution.m_floatTableau) {
+    return p_tableau.LemkePath(p_label, p_abandon, p_data);
+  }
+
+  Array<int> labels(p_tableau.MinRow(), p_tableau.MaxRow());
+  for (int i = labels.First(); i <= labels.Last(); i++) {
+    labels[i] = p_tableau.Label(i);
+  }
+
+  linalg::LHTableau<double> floatTableau(p_solution.CopyFloatTableau());
+
+  FloatPath path;
+  path.m_abandon = p_abandon;
+  path.m_data = p_data;
+  path.m_pivots = 0;
+  path.m_maxPivots = FLOAT_PATH_PIVOTS * labels.Length();
+  if (floatTableau.PivotToBasis(labels) &&
+      floatTableau.LemkePath(p_label, FloatPath::Abandon, &path)) {
+    Array<int> end(labels.First(), labels.Last());
+    for (int i = end.First(); i <= end.Last(); i++) {
+      end[i] = floatTableau.Label(i);
+    }
+    if (p_tableau.PivotToBasis(end) && p_tableau.IsComplementary()) {
+      return 1;
+    }
+    // The starting basis is nonsingular, so it can always be restored
+    p_tableau.PivotToBasis(labels);
+  }
+  else if (p_abandon && p_abandon(p_data)) {
+    return 0;
+  }
+  return p_tableau.LemkePath(p_label, p_abandon, p_data);
+}
+
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
 // calling itself.  p_list maintains the list of basic variables 
@@ -221,12 +389,533 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
   for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
     if (i != j)  {
       linalg::LHTableau<T> Bcopy(B);
-      Bcopy.LemkePath(i);
+      FollowPath(Bcopy, i, p_solution);
       AllLemke(p_game, i, Bcopy, p_solution, depth+1);
     }
   }
 }
 
+#ifdef GAMBIT_THREADS
+
+//
+// Explores the equilibria accessible from the extraneous solution with
+// a pool of threads.  The path for each label from each equilibrium is
+// a task.  Each thread keeps the tasks it creates in its own queue,
+// taking the one created most recently first, so that on its own it
+// searches depth-first; a thread which runs out of tasks takes the
+// oldest one from the queue of another thread.  The tasks coordinate
+// only through the set of complementary bases in the solution, so a
+// path ending at a basis already found is followed no further.
+//
+template <class T>
+class NashLcpStrategySolver<T>::Explorer {
+public:
+  Explorer(const NashLcpStrategySolver<T> &p_solver, const Game &p_game,
+	   Solution &p_solution, int p_numThreads);
+  ~Explorer();
+
+  /// Explore from the extraneous solution at the tableau
+  void Explore(const linalg::LHTableau<T> &p_tableau);
+  /// Returns the message of the exception which stopped the search, if any
+  const std::string &GetError(void) const { return m_error; }
+
+private:
+  // An equilibrium (or the extraneous solution), the label by which it
+  // was reached, and the number of its paths not yet started
+  class Node {
+  public:
+    linalg::LHTableau<T> m_tableau;
+    int m_label, m_depth, m_pending;
+    pthread_mutex_t m_mutex;
+
+    Node(const linalg::LHTableau<T> &p_tableau, int p_label, int p_depth)
+      : m_tableau(p_tableau), m_label(p_label), m_depth(p_depth),
+	m_pending(0)
+    { pthread_mutex_init(&m_mutex, 0); }
+    ~Node() { pthread_mutex_destroy(&m_mutex); }
+  };
+
+  class Task {
+  public:
+    Node *m_node;
+    int m_label;
+
+    Task(void) : m_node(0), m_label(0) { }
+    Task(Node *p_node, int p_label) : m_node(p_node), m_label(p_label) { }
+  };
+
+  class Worker {
+  public:
+    Explorer *m_explorer;
+    int m_index;
+  };
+
+  const NashLcpStrategySolver<T> &m_solver;
+  const Game &m_game;
+  Solution &m_solution;
+  int m_numThreads;
+  std::vector<std::deque<Task> > m_queues;
+  std::vector<pthread_mutex_t> m_queueMutexes;
+  pthread_mutex_t m_mutex;
+  pthread_cond_t m_wake;
+  long m_outstanding, m_queued;
+  bool m_stop;
+  std::string m_error;
+
+  /// Adds the tasks of following each path from the node to the queue
+  void Expand(int p_queue, Node *p_node);
+  /// Takes a task from the queue, or from another queue if it is empty
+  bool Take(int p_queue, Task &p_task);
+  /// Follows the path of the task
+  void Run(int p_queue, const Task &p_task);
+  /// Records that one more path from the node has been started
+  void Release(Node *p_node);
+  /// Stops the search, recording the error message if there is one
+  void Stop(const std::string &p_error = "");
+  /// Runs tasks until all have been run, or the search is stopped
+  void Work(int p_queue);
+  static void *RunWorker(void *p_worker);
+};
+
+template <class T>
+NashLcpStrategySolver<T>::Explorer::Explorer(const NashLcpStrategySolver<T> &p_solver,
+					     const Game &p_game,
+					     Solution &p_solution,
+					     int p_numThreads)
+  : m_solver(p_solver), m_game(p_game), m_solution(p_solution),
+    m_numThreads(p_numThreads), m_queues(p_numThreads),
+    m_queueMutexes(p_numThreads), m_outstanding(0), m_queued(0),
+    m_stop(false)
+{
+  for (int i = 0; i < m_numThreads; i++) {
+    pthread_mutex_init(&m_queueMutexes[i], 0);
+  }
+  pthread_mutex_init(&m_mutex, 0);
+  pthread_cond_init(&m_wake, 0);
+}
+
+template <class T>
+NashLcpStrategySolver<T>::Explorer::~Explorer()
+{
+  for (int i = 0; i < m_numThreads; i++) {
+    pthread_mutex_destroy(&m_queueMutexes[i]);
+  }
+  pthread_mutex_destroy(&m_mutex);
+  pthread_cond_destroy(&m_wake);
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Explorer::Expand(int p_queue, Node *p_node)
+{
+  int count = 0;
+  for (int i = p_node->m_tableau.MinCol(); i <= p_node->m_tableau.MaxCol(); i++) {
+    if (i != p_node->m_label) {
+      count++;
+    }
+  }
+  if (count == 0) {
+    delete p_node;
+    return;
+  }
+  p_node->m_pending = count;
+
+  // Counted first, so that the search cannot be taken as finished while
+  // the tasks are being queued
+  pthread_mutex_lock(&m_mutex);
+  m_outstanding += count;
+  m_queued += count;
+  pthread_mutex_unlock(&m_mutex);
+
+  // Queued in reverse, so that the paths are taken in order of label
+  pthread_mutex_lock(&m_queueMutexes[p_queue]);
+  for (int i = p_node->m_tableau.MaxCol(); i >= p_node->m_tableau.MinCol(); i--) {
+    if (i != p_node->m_label) {
+      m_queues[p_queue].push_back(Task(p_node, i));
+    }
+  }
+  pthread_mutex_unlock(&m_queueMutexes[p_queue]);
+
+  pthread_mutex_lock(&m_mutex);
+  pthread_cond_broadcast(&m_wake);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+template <class T>
+bool NashLcpStrategySolver<T>::Explorer::Take(int p_queue, Task &p_task)
+{
+  bool found = false;
+  pthread_mutex_lock(&m_queueMutexes[p_queue]);
+  if (!m_queues[p_queue].empty()) {
+    p_task = m_queues[p_queue].back();
+    m_queues[p_queue].pop_back();
+    found = true;
+  }
+  pthread_mutex_unlock(&m_queueMutexes[p_queue]);
+
+  for (int i = 1; !found && i < m_numThreads; i++) {
+    int other = (p_queue + i) % m_numThreads;
+    pthread_mutex_lock(&m_queueMutexes[other]);
+    if (!m_queues[other].empty()) {
+      p_task = m_queues[other].front();
+      m_queues[other].pop_front();
+      found = true;
+    }
+    pthread_mutex_unlock(&m_queueMutexes[other]);
+  }
+
+  if (found) {
+    pthread_mutex_lock(&m_mutex);
+    m_queued--;
+    pthread_mutex_unlock(&m_mutex);
+  }
+  return found;
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Explorer::Release(Node *p_node)
+{
+  pthread_mutex_lock(&p_node->m_mutex);
+  int pending = --p_node->m_pending;
+  pthread_mutex_unlock(&p_node->m_mutex);
+  if (pending == 0) {
+    delete p_node;
+  }
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Explorer::Stop(const std::string &p_error)
+{
+  pthread_mutex_lock(&m_mutex);
+  if (!m_stop) {
+    m_stop = true;
+    m_error = p_error;
+  }
+  pthread_cond_broadcast(&m_wake);
+  pthread_mutex_unlock(&m_mutex);
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Explorer::Run(int p_queue, const Task &p_task)
+{
+  Node *parent = p_task.m_node;
+  Node *node = 0;
+  try {
+    pthread_mutex_lock(&m_mutex);
+    bool stopped = m_stop;
+    pthread_mutex_unlock(&m_mutex);
+    if (!stopped) {
+      // Copies of the parent's tableau are made one at a time, as the
+      // copies of a tableau in floating point update the original
+      pthread_mutex_lock(&parent->m_mutex);
+      try {
+	node = new Node(parent->m_tableau, p_task.m_label,
+			parent->m_depth + 1);
+	Detach(node->m_tableau);
+      }
+      catch (...) {
+	pthread_mutex_unlock(&parent->m_mutex);
+	throw;
+      }
+      pthread_mutex_unlock(&parent->m_mutex);
+    }
+    Release(parent);
+    if (!node) {
+      return;
+    }
+
+    m_solver.FollowPath(node->m_tableau, p_task.m_label, m_solution);
+    if (m_solver.OnBFS(m_game, node->m_tableau, m_solution) &&
+	(m_solver.m_maxDepth == 0 || node->m_depth < m_solver.m_maxDepth)) {
+      Expand(p_queue, node);
+      node = 0;
+    }
+  }
+  catch (EquilibriumLimitReached &) {
+    Stop();
+  }
+  catch (std::exception &e) {
+    Stop((*e.what() != '\0') ? e.what() : "unknown error following a path");
+  }
+  catch (...) {
+    Stop("unknown error following a path");
+  }
+  delete node;
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Explorer::Work(int p_queue)
+{
+  while (true) {
+    Task task;
+    if (Take(p_queue, task)) {
+      Run(p_queue, task);
+      pthread_mutex_lock(&m_mutex);
+      if (--m_outstanding == 0) {
+	pthread_cond_broadcast(&m_wake);
+      }
+      pthread_mutex_unlock(&m_mutex);
+      continue;
+    }
+
+    pthread_mutex_lock(&m_mutex);
+    while (!m_stop && m_outstanding > 0 && m_queued == 0) {
+      pthread_cond_wait(&m_wake, &m_mutex);
+    }
+    bool finished = (m_stop || m_outstanding == 0);
+    pthread_mutex_unlock(&m_mutex);
+    if (finished) {
+      return;
+    }
+  }
+}
+
+template <class T>
+void *NashLcpStrategySolver<T>::Explorer::RunWorker(void *p_worker)
+{
+  Worker *worker = static_cast<Worker *>(p_worker);
+  worker->m_explorer->Work(worker->m_index);
+  return 0;
+}
+
+template <class T> void
+NashLcpStrategySolver<T>::Explorer::Explore(const linalg::LHTableau<T> &p_tableau)
+{
+  if (m_solver.m_maxDepth < 0) {
+    return;
+  }
+  Node *root = new Node(p_tableau, 0, 0);
+  Detach(root->m_tableau);
+  Expand(0, root);
+
+  std::vector<Worker> workers(m_numThreads);
+  std::vector<pthread_t> threads(m_numThreads);
+  std::vector<bool> started(m_numThreads, false);
+  for (int i = 0; i < m_numThreads; i++) {
+    workers[i].m_explorer = this;
+    workers[i].m_index = i;
+  }
+  for (int i = 1; i < m_numThreads; i++) {
+    started[i] = (pthread_create(&threads[i], 0, RunWorker, &workers[i]) == 0);
+  }
+  Work(0);
+  for (int i = 1; i < m_numThreads; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+  }
+
+  // Tasks left when the search is stopped still hold their nodes
+  for (int i = 0; i < m_numThreads; i++) {
+    for (size_t j = 0; j < m_queues[i].size(); j++) {
+      Release(m_queues[i][j].m_node);
+    }
+    m_queues[i].clear();
+  }
+}
+
+//
+// Follows the paths from the extraneous solution for the labels at
+// once, up to one for each thread; a thread whose path fails takes the
+// next label not yet started.  Before each pivot, each path checks
+// whether another has already reached an equilibrium, and if so is
+// abandoned.
+//
+template <class T>
+class NashLcpStrategySolver<T>::Racer {
+public:
+  Racer(const NashLcpStrategySolver<T> &p_solver, Solution &p_solution,
+	const linalg::LHTableau<T> &p_tableau, int p_numThreads);
+  ~Racer();
+
+  /// Follows the paths, returning the label of the first to finish
+  int Race(void);
+  /// Returns the message of the exception which stopped a path, if any
+  const std::string &GetError(void) const { return m_error; }
+  /// Returns the tableau at the end of the path for the label
+  linalg::LHTableau<T> &GetTableau(int p_label)
+  { return *m_tableaux[p_label - m_minLabel]; }
+  /// Returns the number of pivots made along the path for the label
+  long NumPivots(int p_label) const
+  { return m_tableaux[p_label - m_minLabel]->NumPivots() - m_startPivots; }
+
+private:
+  const NashLcpStrategySolver<T> &m_solver;
+  Solution &m_solution;
+  int m_minLabel, m_numThreads;
+  long m_startPivots;
+  std::vector<linalg::LHTableau<T> *> m_tableaux;
+  pthread_mutex_t m_mutex;
+  int m_next, m_winner;
+  std::string m_error;
+
+  /// Follows the path for the label, unless another path finishes first
+  void Run(int p_label);
+  /// Follows paths for labels not yet started until one finishes
+  void Work(void);
+  static bool Abandon(void *p_racer);
+  static void *RunWorker(void *p_racer);
+};
+
+template <class T>
+NashLcpStrategySolver<T>::Racer::Racer(const NashLcpStrategySolver<T> &p_solver,
+				       Solution &p_solution,
+				       const linalg::LHTableau<T> &p_tableau,
+				       int p_numThreads)
+  : m_solver(p_solver), m_solution(p_solution), m_minLabel(p_tableau.MinCol()),
+    m_numThreads(p_numThreads), m_startPivots(p_tableau.NumPivots()),
+    m_next(p_tableau.MinCol()), m_winner(0)
+{
+  pthread_mutex_init(&m_mutex, 0);
+  try {
+    for (int i = p_tableau.MinCol(); i <= p_tableau.MaxCol(); i++) {
+      m_tableaux.push_back(0);
+      m_tableaux.back() = new linalg::LHTableau<T>(p_tableau);
+      Detach(*m_tableaux.back());
+    }
+  }
+  catch (...) {
+    for (size_t i = 0; i < m_tableaux.size(); i++) {
+      delete m_tableaux[i];
+    }
+    pthread_mutex_destroy(&m_mutex);
+    throw;
+  }
+}
+
+template <class T>
+NashLcpStrategySolver<T>::Racer::~Racer()
+{
+  for (size_t i = 0; i < m_tableaux.size(); i++) {
+    delete m_tableaux[i];
+  }
+  pthread_mutex_destroy(&m_mutex);
+}
+
+template <class T>
+bool NashLcpStrategySolver<T>::Racer::Abandon(void *p_racer)
+{
+  Racer *racer = static_cast<Racer *>(p_racer);
+  pthread_mutex_lock(&racer->m_mutex);
+  bool finished = (racer->m_winner != 0);
+  pthread_mutex_unlock(&racer->m_mutex);
+  return finished;
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Racer::Run(int p_label)
+{
+  try {
+    if (m_solver.FollowPath(GetTableau(p_label), p_label, m_solution,
+			    Abandon, this)) {
+      pthread_mutex_lock(&m_mutex);
+      if (m_winner == 0) {
+	m_winner = p_label;
+      }
+      pthread_mutex_unlock(&m_mutex);
+    }
+  }
+  catch (std::exception &e) {
+    pthread_mutex_lock(&m_mutex);
+    if (m_error == "") {
+      m_error = e.what();
+    }
+    pthread_mutex_unlock(&m_mutex);
+  }
+  catch (...) {
+    pthread_mutex_lock(&m_mutex);
+    if (m_error == "") {
+      m_error = "unknown error following a path";
+    }
+    pthread_mutex_unlock(&m_mutex);
+  }
+}
+
+template <class T>
+void NashLcpStrategySolver<T>::Racer::Work(void)
+{
+  int numPaths = m_tableaux.size();
+  while (true) {
+    pthread_mutex_lock(&m_mutex);
+    int label = 0;
+    if (m_winner == 0 && m_next < m_minLabel + numPaths) {
+      label = m_next++;
+    }
+    pthread_mutex_unlock(&m_mutex);
+    if (label == 0) {
+      return;
+    }
+    Run(label);
+  }
+}
+
+template <class T>
+void *NashLcpStrategySolver<T>::Racer::RunWorker(void *p_racer)
+{
+  static_cast<Racer *>(p_racer)->Work();
+  return 0;
+}
+
+template <class T> int NashLcpStrategySolver<T>::Racer::Race(void)
+{
+  int numThreads = std::min(m_numThreads, (int) m_tableaux.size());
+  std::vector<pthread_t> threads(numThreads);
+  std::vector<bool> started(numThreads, false);
+  // This thread follows paths as well, so that there is a path even if
+  // no thread can be created
+  for (int i = 1; i < numThreads; i++) {
+    started[i] = (pthread_create(&threads[i], 0, RunWorker, this) == 0);
+  }
+  Work();
+  for (int i = 1; i < numThreads; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+  }
+  return m_winner;
+}
+
+#endif  // GAMBIT_THREADS
+
+//
+// FirstLemke finds one equilibrium, by following the path from the
+// extraneous solution for the first label or, if racing, by following
+// the paths for all labels until one of them finishes.
+//
+template <class T> void
+NashLcpStrategySolver<T>::FirstLemke(const Game &p_game,
+				     linalg::LHTableau<T> &B,
+				     Solution &p_solution) const
+{
+  m_pivotCounts = Array<long>(B.MinCol(), B.MaxCol());
+  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+    m_pivotCounts[i] = 0;
+  }
+  m_raceWinner = 0;
+
+#ifdef GAMBIT_THREADS
+  if (m_race) {
+    Racer racer(*this, p_solution, B, m_numThreads);
+    int winner = racer.Race();
+    for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+      m_pivotCounts[i] = racer.NumPivots(i);
+    }
+    if (winner == 0) {
+      throw std::runtime_error((racer.GetError() != "") ? racer.GetError() :
+			       "no path reached an equilibrium");
+    }
+    m_raceWinner = winner;
+    OnBFS(p_game, racer.GetTableau(winner), p_solution);
+    return;
+  }
+#endif  // GAMBIT_THREADS
+
+  long start = B.NumPivots();
+  FollowPath(B, 1, p_solution);
+  m_pivotCounts[1] = B.NumPivots() - start;
+  m_raceWinner = 1;
+  OnBFS(p_game, B, p_solution);
+}
+
 template <class T> List<MixedStrategyProfile<T> > 
 NashLcpStrategySolver<T>::Solve(const Game &p_game) const
 {
@@ -237,6 +926,12 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
   Solution solution;
+#ifdef GAMBIT_THREADS
+  if ((m_stopAfter != 1 && m_numThreads > 1) || (m_stopAfter == 1 && m_race)) {
+    // Equilibria are computed on the game from the worker threads
+    p_game->PrepareForSharing();
+  }
+#endif  // GAMBIT_THREADS
 
   try {
     Matrix<T> A1 = Make_A1<T>(p_game);
@@ -245,12 +940,30 @@ NashLcpStrategySolver<T>::Solve(const Game &p_game) const
     Vector<T> b2 = Make_b2<T>(p_game);
     linalg::LHTableau<T> B(A1, A2, b1, b2);
 
+    shared_ptr<FloatTableau> floatTableau;
+    if (m_certify) {
+      floatTableau = new FloatTableau(p_game);
+      solution.m_floatTableau = &floatTableau->m_tableau;
+    }
+
     if (m_stopAfter != 1) {
+#ifdef GAMBIT_THREADS
+      if (m_numThreads > 1) {
+	Explorer explorer(*this, p_game, solution, m_numThreads);
+	explorer.Explore(B);
+	if (explorer.GetError() != "") {
+	  throw std::runtime_error(explorer.GetError());
+	}
+      }
+      else {
+	AllLemke(p_game, 0, B, solution, 0);
+      }
+#else
       AllLemke(p_game, 0, B, solution, 0);
+#endif  // GAMBIT_THREADS
     }
     else  {
-      B.LemkePath(1);
-      OnBFS(p_game, B, solution);
+      FirstLemke(p_game, B, solution);
     }
   }
   catch (EquilibriumLimitReached &) {
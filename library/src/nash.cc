@@ -469,6 +469,23 @@ template class BehavViaStrategySolver<Rational>;
 template class SubgameBehavSolver<double>;
 template class SubgameBehavSolver<Rational>;
 
+//========================================================================
+//                        Preprocessing of games
+//========================================================================
+
+Game EliminateDominatedStrategies(const Game &p_game,
+				  int p_numThreads /* = 1 */)
+{
+  StrategySupportProfile support(p_game);
+  IteratedDominance elimination(support, true, false, p_numThreads);
+  elimination.SetMixed(true);
+  elimination.EliminateAll();
+  if (elimination.GetSupport() == support) {
+    return p_game;
+  }
+  return elimination.GetSupport().Restrict();
+}
+
 } // end namespace Gambit::Nash
   
 } // end namespace Gambit
@@ -33,13 +33,98 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cmath>
 #include <cfloat>
 #include <cctype>
+#include <climits>
 
 namespace Gambit {
 
 static const Integer _Int_One(1);
 
+//
+// Small values have numerators and denominators which fit in a long,
+// excluding LONG_MIN so that every small value can be negated.  Sums
+// and products of small numbers are checked for overflow; results
+// which overflow are computed using Integer instead.
+//
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_mul_overflow)
+#define GAMBIT_OVERFLOW_BUILTINS
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 5
+#define GAMBIT_OVERFLOW_BUILTINS
+#endif
+
+// Sets r = a + b, returning false if the sum is not small
+inline static bool SmallAdd(long a, long b, long &r)
+{
+#ifdef GAMBIT_OVERFLOW_BUILTINS
+  return !__builtin_add_overflow(a, b, &r) && r != LONG_MIN;
+#else
+  if ((b > 0 && a > LONG_MAX - b) || (b < 0 && a < -LONG_MAX - b)) {
+    return false;
+  }
+  r = a + b;
+  return true;
+#endif  // GAMBIT_OVERFLOW_BUILTINS
+}
+
+// Sets r = a * b, returning false if the product is not small
+inline static bool SmallMul(long a, long b, long &r)
+{
+#ifdef GAMBIT_OVERFLOW_BUILTINS
+  return !__builtin_mul_overflow(a, b, &r) && r != LONG_MIN;
+#else
+  if (a != 0 && ((b < 0) ? -b : b) > LONG_MAX / ((a < 0) ? -a : a)) {
+    return false;
+  }
+  r = a * b;
+  return true;
+#endif  // GAMBIT_OVERFLOW_BUILTINS
+}
+
+inline static bool IsSmall(const Integer &n)
+{ return n.fits_in_long() && n.as_long() != LONG_MIN; }
+
+// Greatest common divisor of two nonnegative numbers
+static long SmallGCD(long a, long b)
+{
+  while (b != 0) {
+    long t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+struct Rational::BigRep {
+  Integer num, den;
+
+  BigRep(const Integer &p_num, const Integer &p_den)
+    : num(p_num), den(p_den) { }
+};
+
+//
+// The numerator and denominator of a value as Integers.  For a small
+// value these are constructed here; otherwise they refer to those held
+// by the value.  No Integer is assigned to, so that a Rational shared
+// between threads may be read concurrently.
+//
+class Rational::Parts {
+private:
+  Integer m_num, m_den;
+
+public:
+  const Integer &num, &den;
+
+  Parts(const Rational &x)
+    : m_num((x.is_small()) ? Integer(x.m_num) : Integer()),
+      m_den((x.is_small()) ? Integer(x.m_den) : Integer()),
+      num((x.is_small()) ? m_num : x.m_big->num),
+      den((x.is_small()) ? m_den : x.m_big->den) { }
+};
+
 void Rational::normalize(void)
 {
+  Integer &num = m_big->num, &den = m_big->den;
   int s = sign(den);
   if (s == 0)  {
     throw ZeroDivideException();
@@ -54,70 +139,114 @@ void Rational::normalize(void)
     num /= g;
     den /= g;
   }
+  if (IsSmall(num) && IsSmall(den)) {
+    long n = num.as_long(), d = den.as_long();
+    delete m_big;
+    m_num = n;
+    m_den = d;
+  }
+}
+
+void Rational::set_small(long n, long d)
+{
+  if (d < 0) {
+    n = -n;
+    d = -d;
+  }
+  long g = SmallGCD((n < 0) ? -n : n, d);
+  if (g != 1) {
+    n /= g;
+    d /= g;
+  }
+  if (!is_small()) {
+    delete m_big;
+  }
+  m_num = n;
+  m_den = d;
+}
+
+void Rational::set_big(const Integer &n, const Integer &d)
+{
+  if (is_small()) {
+    m_big = new BigRep(n, d);
+    m_den = 0;
+  }
+  else {
+    m_big->num = n;
+    m_big->den = d;
+  }
+  normalize();
 }
 
 void      add(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
-      add(r.num, r.den, r.num);
-      mul(x.den, y.den, r.den);
+  if (x.is_small() && y.is_small()) {
+    long n, d, t1, t2;
+    if (x.m_den == y.m_den) {
+      if (SmallAdd(x.m_num, y.m_num, n)) {
+	r.set_small(n, x.m_den);
+	return;
+      }
     }
-  else
-    {
-      Integer tmp;
-      mul(x.den, y.num, tmp);
-      mul(x.num, y.den, r.num);
-      add(r.num, tmp, r.num);
-      mul(x.den, y.den, r.den);
+    else if (SmallMul(x.m_num, y.m_den, t1) && 
+	     SmallMul(y.m_num, x.m_den, t2) &&
+	     SmallAdd(t1, t2, n) && SmallMul(x.m_den, y.m_den, d)) {
+      r.set_small(n, d);
+      return;
     }
-  r.normalize();
+  }
+  Rational::Parts xp(x), yp(y);
+  r.set_big(xp.num * yp.den + xp.den * yp.num, xp.den * yp.den);
 }
 
 void      sub(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
-      sub(r.num, r.den, r.num);
-      mul(x.den, y.den, r.den);
+  if (x.is_small() && y.is_small()) {
+    long n, d, t1, t2;
+    if (x.m_den == y.m_den) {
+      if (SmallAdd(x.m_num, -y.m_num, n)) {
+	r.set_small(n, x.m_den);
+	return;
+      }
     }
-  else
-    {
-      Integer tmp;
-      mul(x.den, y.num, tmp);
-      mul(x.num, y.den, r.num);
-      sub(r.num, tmp, r.num);
-      mul(x.den, y.den, r.den);
+    else if (SmallMul(x.m_num, y.m_den, t1) && 
+	     SmallMul(-y.m_num, x.m_den, t2) &&
+	     SmallAdd(t1, t2, n) && SmallMul(x.m_den, y.m_den, d)) {
+      r.set_small(n, d);
+      return;
     }
-  r.normalize();
+  }
+  Rational::Parts xp(x), yp(y);
+  r.set_big(xp.num * yp.den - xp.den * yp.num, xp.den * yp.den);
 }
 
 void      mul(const Rational& x, const Rational& y, Rational& r)
 {
-  mul(x.num, y.num, r.num);
-  mul(x.den, y.den, r.den);
-  r.normalize();
+  if (x.is_small() && y.is_small()) {
+    long n, d;
+    if (SmallMul(x.m_num, y.m_num, n) && SmallMul(x.m_den, y.m_den, d)) {
+      r.set_small(n, d);
+      return;
+    }
+  }
+  Rational::Parts xp(x), yp(y);
+  r.set_big(xp.num * yp.num, xp.den * yp.den);
 }
 
 void      div(const Rational& x, const Rational& y, Rational& r)
 {
-  if (&r != &x && &r != &y)
-    {
-      mul(x.num, y.den, r.num);
-      mul(x.den, y.num, r.den);
-    }
-  else
-    {
-      Integer tmp;
-      mul(x.num, y.den, tmp);
-      mul(y.num, x.den, r.den);
-      r.num = tmp;
+  if (sign(y) == 0) {
+    throw ZeroDivideException();
+  }
+  if (x.is_small() && y.is_small()) {
+    long n, d;
+    if (SmallMul(x.m_num, y.m_den, n) && SmallMul(x.m_den, y.m_num, d)) {
+      r.set_small(n, d);
+      return;
     }
-  r.normalize();
+  }
+  Rational::Parts xp(x), yp(y);
+  r.set_big(xp.num * yp.den, xp.den * yp.num);
 }
 
 
@@ -125,32 +254,58 @@ void      div(const Rational& x, const Rational& y, Rational& r)
 
 void Rational::invert(void)
 {
-  Integer tmp = num;  
-  num = den;  
-  den = tmp;  
-  int s = sign(den);
-  if (s == 0) {
-    throw ZeroDivideException();
+  if (is_small()) {
+    if (m_num == 0) {
+      throw ZeroDivideException();
+    }
+    long tmp = m_num;
+    m_num = m_den;
+    m_den = tmp;
+    if (m_den < 0) {
+      m_num = -m_num;
+      m_den = -m_den;
+    }
+    return;
   }
-  else if (s < 0)  {
-    den.negate();
-    num.negate();
+
+  Integer tmp = m_big->num;  
+  m_big->num = m_big->den;  
+  m_big->den = tmp;  
+  if (sign(m_big->den) < 0)  {
+    m_big->den.negate();
+    m_big->num.negate();
   }
 }
 
 int compare(const Rational& x, const Rational& y)
 {
-  int xsgn = sign(x.num);
-  int ysgn = sign(y.num);
+  if (x.is_small() && y.is_small()) {
+    if (x.m_den == y.m_den) {
+      return (x.m_num > y.m_num) - (x.m_num < y.m_num);
+    }
+    long a, b;
+    if (SmallMul(x.m_num, y.m_den, a) && SmallMul(y.m_num, x.m_den, b)) {
+      return (a > b) - (a < b);
+    }
+  }
+  Rational::Parts xp(x), yp(y);
+  int xsgn = sign(xp.num);
+  int ysgn = sign(yp.num);
   int d = xsgn - ysgn;
-  if (d == 0 && xsgn != 0) d = compare(x.num * y.den, x.den * y.num);
+  if (d == 0 && xsgn != 0) d = compare(xp.num * yp.den, xp.den * yp.num);
   return d;
 }
 
 Rational::Rational(double x)
+  : m_num(0), m_den(1)
 {
-  num = 0;
-  den = 1;
+  // (double) LONG_MAX is 2^63, so the conversion of x is exact
+  if (x == floor(x) && x > -(double) LONG_MAX && x < (double) LONG_MAX) {
+    m_num = (long) x;
+    return;
+  }
+
+  Integer num = 0, den = 1;
   if (x != 0.0)
     {
       int neg = x < 0;
@@ -181,13 +336,14 @@ Rational::Rational(double x)
       if (neg)
 	num.negate();
     }
-  normalize();
+  set_big(num, den);
 }
 
 
 Integer trunc(const Rational& x)
 {
-  return x.num / x.den ;
+  Rational::Parts xp(x);
+  return xp.num / xp.den;
 }
 
 
@@ -205,7 +361,7 @@ Rational Rational::operator-(void) const
 Rational abs(const Rational& x) 
 {
   Rational r(x);
-  if (sign(r.num) < 0) r.negate();
+  if (sign(r) < 0) r.negate();
   return r;
 }
 
@@ -213,39 +369,40 @@ Rational abs(const Rational& x)
 Rational sqr(const Rational& x)
 {
   Rational r;
-  mul(x.num, x.num, r.num);
-  mul(x.den, x.den, r.den);
-  r.normalize();
+  mul(x, x, r);
   return r;
 }
 
 Integer floor(const Rational& x)
 {
+  Rational::Parts xp(x);
   Integer q;
   Integer r;
-  divide(x.num, x.den, q, r);
-  if (sign(x.num) < 0 && sign(r) != 0) --q;
+  divide(xp.num, xp.den, q, r);
+  if (sign(xp.num) < 0 && sign(r) != 0) --q;
   return q;
 }
 
 Integer ceil(const Rational& x)
 {
+  Rational::Parts xp(x);
   Integer q;
   Integer  r;
-  divide(x.num, x.den, q, r);
-  if (sign(x.num) >= 0 && sign(r) != 0) ++q;
+  divide(xp.num, xp.den, q, r);
+  if (sign(xp.num) >= 0 && sign(r) != 0) ++q;
   return q;
 }
 
 Integer round(const Rational& x) 
 {
+  Rational::Parts xp(x);
   Integer q;
   Integer r;
-  divide(x.num, x.den, q, r);
+  divide(xp.num, xp.den, q, r);
   r <<= 1;
-  if (ucompare(r, x.den) >= 0)
+  if (ucompare(r, xp.den) >= 0)
     {
-      if (sign(x.num) >= 0)
+      if (sign(xp.num) >= 0)
 	++q;
       else
 	--q;
@@ -255,35 +412,40 @@ Integer round(const Rational& x)
 
 Rational pow(const Rational& x, long y)
 {
-  Rational r;
+  Rational::Parts xp(x);
+  Integer num, den;
   if (y >= 0)
     {
-      pow(x.num, y, r.num);
-      pow(x.den, y, r.den);
+      pow(xp.num, y, num);
+      pow(xp.den, y, den);
     }
   else
     {
       y = -y;
-      pow(x.num, y, r.den);
-      pow(x.den, y, r.num);
-      if (sign(r.den) < 0)
-	{
-	  r.num.negate();
-	  r.den.negate();
-	}
+      pow(xp.num, y, den);
+      pow(xp.den, y, num);
     }
+  Rational r;
+  r.set_big(num, den);
   return r;
 }
 
 std::ostream &operator << (std::ostream &s, const Rational& y)
 {
-  if (y.denominator() == 1L)
-    s << y.numerator();
+  if (y.is_small()) {
+    s << y.m_num;
+    if (y.m_den != 1) {
+      s << "/" << y.m_den;
+    }
+    return s;
+  }
+  if (y.m_big->den == 1L)
+    s << y.m_big->num;
   else
     {
-      s << y.numerator();
+      s << y.m_big->num;
       s << "/";
-      s << y.denominator();
+      s << y.m_big->den;
     }
   return s;
 }
@@ -357,17 +519,22 @@ std::istream &operator>>(std::istream &f, Rational &y)
   }
 
   y = Rational(num * sign, denom);
-  y.normalize();
 
   return f;
 }
 
 bool Rational::OK(void) const
 {
+  if (is_small()) {
+    return m_den > 0 && m_num != LONG_MIN &&
+      SmallGCD((m_num < 0) ? -m_num : m_num, m_den) == 1;
+  }
+  const Integer &num = m_big->num, &den = m_big->den;
   int v = num.OK() && den.OK(); // have valid num and denom
   if (v)   {
     v &= sign(den) > 0;           // denominator positive;
     v &=  ucompare(gcd(num, den), _Int_One) == 0; // relatively prime
+    v &= !IsSmall(num) || !IsSmall(den);  // unique representation
   }
   // if (!v) error("invariant failure");
   return v;
@@ -390,60 +557,122 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
+Rational::Rational() 
+  : m_num(0), m_den(1) {}
 
-Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
-Rational::~Rational() {}
+Rational::~Rational()
+{
+  if (!is_small()) {
+    delete m_big;
+  }
+}
 
-Rational::Rational(const Rational& y) :num(y.num), den(y.den) {}
+Rational::Rational(const Rational& y) 
+  : m_num(y.m_num), m_den(y.m_den)
+{
+  if (!y.is_small()) {
+    m_big = new BigRep(*y.m_big);
+  }
+}
 
-Rational::Rational(const Integer& n) :num(n), den(&_OneRep) {}
+Rational::Rational(const Integer& n) 
+  : m_num(0), m_den(1)
+{
+  if (IsSmall(n)) {
+    m_num = n.as_long();
+  }
+  else {
+    set_big(n, _Int_One);
+  }
+}
 
 Rational::Rational(const Integer& n, const Integer& d) 
- : num(n), den(d)
+  : m_num(0), m_den(1)
 {
   if (d == 0)  {
     throw ZeroDivideException();
   }
-  normalize();
+  if (IsSmall(n) && IsSmall(d)) {
+    set_small(n.as_long(), d.as_long());
+  }
+  else {
+    set_big(n, d);
+  }
 }
 
-Rational::Rational(long n) :num(n), den(&_OneRep) { }
+Rational::Rational(long n) 
+  : m_num(n), m_den(1)
+{ 
+  if (n == LONG_MIN) {
+    m_den = 0;
+    m_big = new BigRep(Integer(n), _Int_One);
+  }
+}
 
-Rational::Rational(int n) :num(n), den(&_OneRep) { }
+Rational::Rational(int n) 
+  : m_num(n), m_den(1)
+{ }
 
 Rational::Rational(long n, long d) 
- : num(n), den(d)
+  : m_num(0), m_den(1)
 {
   if (d == 0) {
     throw ZeroDivideException();
   }
-  normalize();
+  if (n == LONG_MIN || d == LONG_MIN) {
+    set_big(Integer(n), Integer(d));
+  }
+  else {
+    set_small(n, d);
+  }
 }
 
 Rational::Rational(int n, int d) 
- : num(n), den(d) 
+  : m_num(0), m_den(1)
 { 
   if (d == 0) {
     throw ZeroDivideException();
   }
-  normalize(); 
+  set_small(n, d);
 }
 
 Rational &Rational::operator =  (const Rational& y)
 {
-  num = y.num;  den = y.den;   return *this;
+  if (this == &y) {
+    return *this;
+  }
+  if (y.is_small()) {
+    if (!is_small()) {
+      delete m_big;
+    }
+    m_num = y.m_num;
+    m_den = y.m_den;
+  }
+  else if (is_small()) {
+    m_big = new BigRep(*y.m_big);
+    m_den = 0;
+  }
+  else {
+    m_big->num = y.m_big->num;
+    m_big->den = y.m_big->den;
+  }
+  return *this;
 }
 
+// The representation of each value is unique, so values held in
+// different representations are never equal.
 bool Rational::operator==(const Rational &y) const
 {
-  return compare(num, y.num) == 0 && compare(den, y.den) == 0;
+  if (is_small() || y.is_small()) {
+    return m_den == y.m_den && m_num == y.m_num;
+  }
+  return (compare(m_big->num, y.m_big->num) == 0 &&
+	  compare(m_big->den, y.m_big->den) == 0);
 }
 
 bool Rational::operator!=(const Rational &y) const
 {
-  return compare(num, y.num) != 0 || compare(den, y.den) != 0;
+  return !(*this == y);
 }
 
 bool Rational::operator< (const Rational &y) const
@@ -468,12 +697,19 @@ bool Rational::operator>=(const Rational &y) const
 
 int sign(const Rational& x)
 {
-  return sign(x.num);
+  if (x.is_small()) {
+    return (x.m_num > 0) - (x.m_num < 0);
+  }
+  return sign(x.m_big->num);
 }
 
 void Rational::negate()
 {
-  num.negate();
+  if (is_small()) {
+    m_num = -m_num;
+    return;
+  }
+  m_big->num.negate();
 }
 
 
@@ -501,15 +737,25 @@ Rational &Rational::operator/=(const Rational& y)
   return *this;
 }
 
-const Integer& Rational::numerator() const { return num; }
-const Integer& Rational::denominator() const { return den; }
+Integer Rational::numerator() const
+{ return (is_small()) ? Integer(m_num) : m_big->num; }
+
+Integer Rational::denominator() const
+{ return (is_small()) ? Integer(m_den) : m_big->den; }
 
 Rational::operator double(void) const 
 {
+  // Integers of less than 2^53 in absolute value are exactly
+  // representable, which is also what ratio() yields for them.  Other
+  // small values are converted via Integer as well, so that the result
+  // does not depend on the representation.
+  if (is_small() && m_den == 1 && fabs((double) m_num) < 9007199254740992.0) {
+    return (double) m_num;
+  }
   // We approach this in terms of absolute values because there is
   // (apparently) a bug in ratio() which yields incorrect results
   // for some negative numbers (TLT, 27 Feb 2006).
-  Integer x(num), y(den);
+  Integer x(numerator()), y(denominator());
   x.abs();
   y.abs();
   
@@ -537,107 +783,142 @@ Rational Rational::operator/(const Rational &y) const
 }
 
 
-template<>
-Rational lexical_cast(const std::string &f)
+namespace {
+
+//
+// Accumulates the digits of a decimal number.  The value is held in a
+// machine integer while it fits, and is promoted to Integer only if it
+// grows too large; most numbers in game files are short.  The machine
+// value is kept within the range of an int, as Integer(long) does not
+// hold more than 32 bits on all platforms.
+//
+class DecimalAccumulator {
+private:
+  long m_small;
+  Integer m_big;
+  bool m_isBig;
+
+public:
+  DecimalAccumulator(long p_value) : m_small(p_value), m_isBig(false) { }
+
+  /// Appends a digit to the value, that is, sets it to 10 * value + digit
+  void Append(int p_digit)
+  {
+    if (!m_isBig) {
+      if (m_small <= (INT_MAX - 9) / 10) {
+	m_small = 10 * m_small + p_digit;
+	return;
+      }
+      m_big = Integer(m_small);
+      m_isBig = true;
+    }
+    m_big *= 10;
+    m_big += p_digit;
+  }
+
+  bool IsSmall(void) const { return !m_isBig; }
+  long GetSmall(void) const { return m_small; }
+  Integer GetValue(void) const { return (m_isBig) ? m_big : Integer(m_small); }
+};
+
+//
+// Returns the character at p_pos and advances it.  Characters past the
+// end of the text read as '\0', as the terminator of a C string would.
+//
+inline char NextChar(const char *&p_pos, const char *p_end)
+{
+  return (p_pos < p_end) ? *p_pos++ : '\0';
+}
+
+//
+// Reads an exponent following 'e' or 'E', and scales the number
+// accordingly.
+//
+char ReadExponent(const char *&p_pos, const char *p_end,
+		  DecimalAccumulator &p_num, DecimalAccumulator &p_denom)
+{
+  int expsign = 1;
+  DecimalAccumulator exponent(0);
+  char ch = NextChar(p_pos, p_end);
+  if (ch == '-')  {
+    expsign = -1;
+    ch = NextChar(p_pos, p_end);
+  }
+  while (ch >= '0' && ch <= '9') {
+    exponent.Append(ch - '0');
+    ch = NextChar(p_pos, p_end);
+  }
+  if (!exponent.IsSmall()) {
+    throw ValueException();
+  }
+  DecimalAccumulator &scaled = (expsign > 0) ? p_num : p_denom;
+  for (long i = 0; i < exponent.GetSmall(); i++) {
+    scaled.Append(0);
+  }
+  return ch;
+}
+
+}  // end anonymous namespace
+
+Rational ToRational(const char *p_begin, const char *p_end)
 {
+  const char *pos = p_begin;
   char ch = ' ';
   int sign = 1;
-  unsigned int index = 0, length = f.length();
-  Integer num = 0, denom = 1;
+  DecimalAccumulator num(0), denom(1);
 
-  while (isspace(ch) && index<=length) {
-    ch = f[index++];
+  while (isspace(ch)) {
+    ch = NextChar(pos, p_end);
   }
 
-  if (ch == '-' && index<=length)  {
+  if (ch == '-')  {
     sign = -1;
-    ch=f[index++];
+    ch = NextChar(pos, p_end);
   }
 
-  while (ch >= '0' && ch <= '9' && index<=length)   {
-    num *= 10;
-    num += (int) (ch - '0');
-    ch=f[index++];
+  while (ch >= '0' && ch <= '9')   {
+    num.Append(ch - '0');
+    ch = NextChar(pos, p_end);
   }
 
   if (ch == '/')  {
-    denom = 0;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      denom += (int) (ch - '0');
-      ch=f[index++];
+    denom = DecimalAccumulator(0);
+    ch = NextChar(pos, p_end);
+    while (ch >= '0' && ch <= '9')  {
+      denom.Append(ch - '0');
+      ch = NextChar(pos, p_end);
     }
   }
   else if (ch == '.')  {
-    denom = 1;
-    ch=f[index++];
-    while (ch >= '0' && ch <= '9' && index<=length)  {
-      denom *= 10;
-      num *= 10;
-      num += (int) (ch - '0');
-      ch=f[index++];
+    ch = NextChar(pos, p_end);
+    while (ch >= '0' && ch <= '9')  {
+      denom.Append(0);
+      num.Append(ch - '0');
+      ch = NextChar(pos, p_end);
     }
     
     if (ch == 'e' || ch == 'E') {
-      int expsign = 1;
-      Integer exponent = 0;
-      ch = f[index++];
-      if (ch == '-')  {
-	expsign = -1;
-	ch = f[index++];
-      }
-      while (ch >= '0' && ch <= '9' && index <= length) {
-	exponent *= 10;
-	exponent += (int) (ch - '0');
-	ch = f[index++];
-      }
-      if (exponent * expsign > 0) {
-	while (exponent > 0) {
-	  num *= 10;
-	  exponent -= 1;
-	}
-      }
-      else if (exponent * expsign < 0) {
-	while (exponent > 0) {
-	  denom *= 10;
-	  exponent -= 1;
-	}
-      }
+      ch = ReadExponent(pos, p_end, num, denom);
     }
   }
   else if (ch == 'e' || ch == 'E') {
-    int expsign = 1;
-    Integer exponent = 0;
-    ch = f[index++];
-    if (ch == '-')  {
-      expsign = -1;
-      ch = f[index++];
-    }
-    while (ch >= '0' && ch <= '9' && index <= length) {
-      exponent *= 10;
-      exponent += (int) (ch - '0');
-      ch = f[index++];
-    }
-    if (exponent * expsign > 0) {
-      while (exponent > 0) {
-	num *= 10;
-	exponent -= 1;
-      }
-    }
-    else if (exponent * expsign < 0) {
-      while (exponent > 0) {
-	denom *= 10;
-	exponent -= 1;
-      }
-    }
+    ch = ReadExponent(pos, p_end, num, denom);
   }
 
   if (ch != '\0') {
     throw ValueException();
   }
 
-  return Rational(num * sign, denom);
+  if (num.IsSmall() && denom.IsSmall()) {
+    return Rational(sign * num.GetSmall(), denom.GetSmall());
+  }
+  return Rational(num.GetValue() * sign, denom.GetValue());
+}
+
+template<>
+Rational lexical_cast(const std::string &f)
+{
+  return ToRational(f.data(), f.data() + f.length());
 }
 
 }  // end namespace Gambit
@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+
 #include "gambit/gambit.h"
 
 namespace Gambit {
@@ -33,8 +35,20 @@ namespace Gambit {
 //---------------------------------------------------------------------------
 
 StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p_support)
-  : m_atEnd(false), m_support(p_support),
+  : m_atEnd(false), m_grayCode(false), m_support(p_support),
     m_currentStrat(m_support.GetGame()->NumPlayers()),
+    m_direction(m_support.GetGame()->NumPlayers()),
+    m_profile(m_support.GetGame()->NewPureStrategyProfile()), 
+    m_frozen1(0), m_frozen2(0)
+{
+  First();
+}
+
+StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p_support,
+						 bool p_grayCode)
+  : m_atEnd(false), m_grayCode(p_grayCode), m_support(p_support),
+    m_currentStrat(m_support.GetGame()->NumPlayers()),
+    m_direction(m_support.GetGame()->NumPlayers()),
     m_profile(m_support.GetGame()->NewPureStrategyProfile()), 
     m_frozen1(0), m_frozen2(0)
 {
@@ -43,8 +57,9 @@ StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p
 
 StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p_support,
 						 int pl, int st)
-  : m_atEnd(false), m_support(p_support), 
+  : m_atEnd(false), m_grayCode(false), m_support(p_support), 
     m_currentStrat(m_support.GetGame()->NumPlayers()),
+    m_direction(m_support.GetGame()->NumPlayers()),
     m_profile(m_support.GetGame()->NewPureStrategyProfile()), 
     m_frozen1(pl), m_frozen2(0)
 {
@@ -55,13 +70,14 @@ StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p
 
 StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p_support,
 						 const GameStrategy &p_strategy)
-  : m_atEnd(false), m_support(p_support),
+  : m_atEnd(false), m_grayCode(false), m_support(p_support),
     m_currentStrat(p_support.GetGame()->NumPlayers()),
+    m_direction(p_support.GetGame()->NumPlayers()),
     m_profile(p_support.GetGame()->NewPureStrategyProfile()), 
     m_frozen1(p_strategy->GetPlayer()->GetNumber()),
     m_frozen2(0)
 {
-  m_currentStrat[m_frozen1] = p_strategy->GetNumber();
+  m_currentStrat[m_frozen1] = p_support.GetIndex(p_strategy);
   m_profile->SetStrategy(p_strategy);
   First();
 }
@@ -70,8 +86,9 @@ StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p
 StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p_support,
 						 int pl1, int st1,
 						 int pl2, int st2)
-  : m_atEnd(false), m_support(p_support), 
+  : m_atEnd(false), m_grayCode(false), m_support(p_support), 
     m_currentStrat(m_support.GetGame()->NumPlayers()),
+    m_direction(m_support.GetGame()->NumPlayers()),
     m_profile(m_support.GetGame()->NewPureStrategyProfile()), 
     m_frozen1(pl1), m_frozen2(pl2)
 {
@@ -88,15 +105,67 @@ StrategyProfileIterator::StrategyProfileIterator(const StrategySupportProfile &p
 
 void StrategyProfileIterator::First(void)
 {
+  m_strategies = m_support.m_support;
   for (int pl = 1; pl <= m_support.GetGame()->NumPlayers(); pl++) {
+    m_direction[pl] = 1;
     if (pl == m_frozen1 || pl == m_frozen2) continue;
-    m_profile->SetStrategy(m_support.GetStrategy(pl, 1));
+    m_profile->SetStrategy(m_strategies[pl][1]);
     m_currentStrat[pl] = 1;
+    // From here on, the profile holds the handle of the current strategy
+    m_strategies[pl][1] = 0;
   }	
+  m_index = 1L;
+  for (int pl = 1; pl <= m_support.GetGame()->NumPlayers(); pl++) {
+    m_index += m_profile->GetStrategy(pl)->m_offset;
+  }
+  m_position = 0L;
+  m_end = NumContingencies();
+}
+
+//
+// The handles are exchanged between the profile and m_strategies rather
+// than copied, so no reference counts change; these are shared between
+// threads iterating over the same game.
+//
+void StrategyProfileIterator::SetStrategy(int pl, int st)
+{
+  if (st == m_currentStrat[pl]) {
+    return;
+  }
+  PureStrategyProfileRep *profile = m_profile;
+  GameStrategy &current = profile->m_profile[pl];
+  long change = (static_cast<GameStrategyRep *>(m_strategies[pl][st])->m_offset -
+		 static_cast<GameStrategyRep *>(current)->m_offset);
+  m_index += change;
+  profile->m_index += change;
+  current.Swap(m_strategies[pl][m_currentStrat[pl]]);
+  current.Swap(m_strategies[pl][st]);
+  m_currentStrat[pl] = st;
 }
 
 void StrategyProfileIterator::operator++(void)
 {
+  if (++m_position >= m_end) {
+    m_atEnd = true;
+    return;
+  }
+
+  if (m_grayCode) {
+    // Advance the first player who can move in their current direction;
+    // the players before them reverse direction, staying where they are
+    for (int pl = 1; pl <= m_currentStrat.Length(); pl++) {
+      if (pl == m_frozen1 || pl == m_frozen2) continue;
+      int st = m_currentStrat[pl] + m_direction[pl];
+      if (st >= 1 && st <= m_support.NumStrategies(pl)) {
+	SetStrategy(pl, st);
+	return;
+      }
+      m_direction[pl] = -m_direction[pl];
+    }
+    m_atEnd = true;
+    return;
+  }
+
   int pl = 1;
 
   while (1)   {
@@ -110,11 +179,10 @@ void StrategyProfileIterator::operator++(void)
     }
 
     if (m_currentStrat[pl] < m_support.NumStrategies(pl)) {
-      m_profile->SetStrategy(m_support.GetStrategy(pl, ++(m_currentStrat[pl])));
+      SetStrategy(pl, m_currentStrat[pl] + 1);
       return;
     }
-    m_profile->SetStrategy(m_support.GetStrategy(pl, 1));
-    m_currentStrat[pl] = 1;
+    SetStrategy(pl, 1);
     pl++;
     if (pl > m_support.GetGame()->NumPlayers()) {
       m_atEnd = true;
@@ -123,4 +191,70 @@ void StrategyProfileIterator::operator++(void)
   }
 }
 
+//---------------------------------------------------------------------------
+//                          Ranges of contingencies
+//---------------------------------------------------------------------------
+
+long StrategyProfileIterator::NumContingencies(void) const
+{
+  long count = 1L;
+  for (int pl = 1; pl <= m_currentStrat.Length(); pl++) {
+    if (pl != m_frozen1 && pl != m_frozen2) {
+      count *= m_support.NumStrategies(pl);
+    }
+  }
+  return count;
+}
+
+void StrategyProfileIterator::SetRange(long p_begin, long p_end)
+{
+  m_end = std::min(p_end, NumContingencies());
+  m_position = p_begin;
+  m_atEnd = (m_position >= m_end);
+  if (m_atEnd) {
+    return;
+  }
+
+  // The strategies are the digits of the position, with the first
+  // player's the least significant.  In Gray-code order, a player's
+  // digits run backwards after an odd number of passes through them.
+  long position = p_begin;
+  for (int pl = 1; pl <= m_currentStrat.Length(); pl++) {
+    if (pl == m_frozen1 || pl == m_frozen2) continue;
+    int n = m_support.NumStrategies(pl);
+    int digit = position % n;
+    position /= n;
+    if (m_grayCode && position % 2 == 1) {
+      SetStrategy(pl, n - digit);
+      m_direction[pl] = -1;
+    }
+    else {
+      SetStrategy(pl, digit + 1);
+      m_direction[pl] = 1;
+    }
+  }
+}
+
+Array<long> SplitContingencies(long p_count, int p_chunks)
+{
+  // There is always at least one range, even if empty
+  p_chunks = std::max(p_chunks, 1);
+  Array<long> bounds(p_chunks + 1);
+  long size = p_count / p_chunks, extra = p_count % p_chunks;
+  for (int i = 1; i <= p_chunks + 1; i++) {
+    bounds[i] = (i - 1) * size + std::min((long) (i - 1), extra);
+  }
+  return bounds;
+}
+
+Array<long> SplitContingencies(const StrategySupportProfile &p_support,
+			       int p_chunks)
+{
+  long count = 1L;
+  for (int pl = 1; pl <= p_support.NumPlayers(); pl++) {
+    count *= p_support.NumStrategies(pl);
+  }
+  return SplitContingencies(count, p_chunks);
+}
+
 } // end namespace Gambit
@@ -20,11 +20,145 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/linalg/lpsolve.h"
 
 namespace Gambit {
 
+//
+// The payoffs to a player from some of their strategies, on each
+// profile of the other players' strategies in a support.  Profiles are
+// numbered from zero, in the order of contingencies, and are identified
+// by the index their contingency would have in the payoff tables of a
+// table game, were the player to play their first strategy.
+//
+// Payoffs are compared as doubles where these are clearly apart, and
+// exactly otherwise.  Exact payoffs are held as pointers into the payoff
+// tables of a table game, or into a store of the payoffs computed when
+// the slices are gathered for other games.  For each pair of strategies,
+// the profile at which one was last found not to dominate the other is
+// remembered, and tried first when the two are compared again.
+//
+class StrategyPayoffSlices {
+public:
+  StrategyPayoffSlices(const StrategySupportProfile &p_support,
+		       const Array<GameStrategy> &p_strategies);
+
+  /// Returns the number of strategies held
+  int NumStrategies(void) const { return m_strategies.Length(); }
+  /// Returns the st'th strategy held
+  const GameStrategy &GetStrategy(int st) const { return m_strategies[st]; }
+  /// Returns the position of the strategy among those held (0 if absent)
+  int Find(const GameStrategy &p_strategy) const
+  { return m_positions[p_strategy->GetNumber()]; }
+
+  /// \brief Returns true if the s'th strategy held dominates the t'th
+  ///
+  /// Calls for different t may be made at the same time from separate
+  /// threads.
+  bool Dominates(int s, int t, bool p_strict);
+  /// \brief Returns true if the t'th strategy held is strictly dominated
+  /// by a mixture of the strategies held at the given positions
+  ///
+  /// The positions may include t itself.
+  bool IsMixedDominated(int t, const Array<int> &p_strategies) const;
+
+  /// Drops the profiles not in the support, which must be a subset
+  /// of the one on which the slices were last gathered or restricted
+  void Restrict(const StrategySupportProfile &p_support);
+
+private:
+  int m_player;
+  Array<GameStrategy> m_strategies;
+  Array<int> m_positions;
+  /// The distance between contingencies differing by one strategy
+  Array<long> m_strides;
+  /// The indices identifying the profiles
+  std::vector<long> m_keys;
+  /// The payoffs of each strategy held, as doubles and exactly
+  std::vector<std::vector<double> > m_values;
+  std::vector<std::vector<const Rational *> > m_exact;
+  /// The exact payoffs, for games other than tables
+  std::vector<Rational> m_payoffs;
+  /// The least and greatest payoff of each strategy held
+  std::vector<double> m_least, m_greatest;
+  /// For each pair of strategies, a profile showing that the first
+  /// does not dominate the second (-1 if none is known)
+  std::vector<long> m_witnesses;
+
+  /// Collects the indices of the profiles in the support, in order
+  void GetKeys(const StrategySupportProfile &, std::vector<long> &) const;
+  /// Computes the least and greatest payoffs of each strategy held
+  void ComputeBounds(void);
+  /// Returns the sign of the difference of the payoffs of strategies s and t
+  int Compare(int s, int t, long p_profile) const;
+};
+
+namespace {
+
+/// The relative difference below which doubles are compared exactly
+const double c_tolerance = 1.0e-12;
+
+//
+// Returns true if a is less than b, by more than the error in converting
+// exact payoffs to doubles
+//
+inline bool IsClearlyLess(double a, double b)
+{
+  return (a < b - c_tolerance * (1.0 + std::fabs(a) + std::fabs(b)));
+}
+
+//
+// The strategies of a player dominated by others, among a range of
+// candidate strategies, for one level of an elimination
+//
+class DominanceTask : public ParallelTask {
+private:
+  StrategyPayoffSlices &m_slices;
+  const Array<int> &m_dominators, &m_candidates;
+  bool m_strict, m_mixed;
+  long m_begin, m_end;
+  std::vector<char> &m_dominated;
+
+public:
+  DominanceTask(StrategyPayoffSlices &p_slices,
+		const Array<int> &p_dominators, const Array<int> &p_candidates,
+		bool p_strict, bool p_mixed,
+		long p_begin, long p_end, std::vector<char> &p_dominated)
+    : m_slices(p_slices),
+      m_dominators(p_dominators), m_candidates(p_candidates),
+      m_strict(p_strict), m_mixed(p_mixed),
+      m_begin(p_begin), m_end(p_end), m_dominated(p_dominated) { }
+
+  virtual ~DominanceTask() { }
+
+  virtual void Run(void)
+  {
+    for (long i = m_begin; i < m_end; i++) {
+      int t = m_candidates[i + 1];
+      for (int j = 1; j <= m_dominators.Length(); j++) {
+	int s = m_dominators[j];
+	if (s != t && m_slices.Dominates(s, t, m_strict)) {
+	  m_dominated[i] = 1;
+	  break;
+	}
+      }
+      if (!m_dominated[i] && m_mixed &&
+	  m_slices.IsMixedDominated(t, m_dominators)) {
+	m_dominated[i] = 1;
+      }
+    }
+  }
+};
+
+}  // end anonymous namespace
+
+
 //===========================================================================
 //                          class StrategySupportProfile
 //===========================================================================
@@ -34,16 +168,25 @@ namespace Gambit {
 //---------------------------------------------------------------------------
 
 StrategySupportProfile::StrategySupportProfile(const Game &p_nfg)
-  : m_nfg(p_nfg), m_profileIndex(p_nfg->MixedProfileLength())
+  : m_nfg(p_nfg),
+    m_members(p_nfg->MixedProfileLength() / c_wordBits + 1, 0UL),
+    m_ranks(m_members.size(), 0)
 { 
-  for (int pl = 1, index = 1; pl <= p_nfg->NumPlayers(); pl++) {
+  for (int pl = 1; pl <= p_nfg->NumPlayers(); pl++) {
     m_support.Append(Array<GameStrategy>());
-    for (int st = 1; st <= p_nfg->GetPlayer(pl)->NumStrategies(); 
-	 st++, index++) {
+    for (int st = 1; st <= p_nfg->GetPlayer(pl)->NumStrategies(); st++) {
       m_support[pl].Append(p_nfg->GetPlayer(pl)->GetStrategy(st));
-      m_profileIndex[index] = index;
     }
   }
+  // All strategies are in the support; ids run from 1 up
+  int length = p_nfg->MixedProfileLength();
+  for (size_t word = 0; word < m_members.size(); word++) {
+    int bits = std::min(length - (int) word * c_wordBits, (int) c_wordBits);
+    if (bits > 0) {
+      m_members[word] = (bits == c_wordBits) ? ~0UL : ((1UL << bits) - 1);
+    }
+    m_ranks[word] = std::min(length, (int) word * c_wordBits);
+  }
 }
 
 //---------------------------------------------------------------------------
@@ -62,10 +205,16 @@ Array<int> StrategySupportProfile::NumStrategies(void) const
 
 int StrategySupportProfile::MixedProfileLength(void) const
 {
-  int total = 0;
-  for (int pl = 1; pl <= m_nfg->NumPlayers();
-       total += m_support[pl++].Length());
-  return total;
+  return m_ranks.back() + CountBits(m_members.back());
+}
+
+int StrategySupportProfile::GetIndex(const GameStrategy &s) const
+{
+  if (!Contains(s)) {
+    return 0;
+  }
+  return (CountBefore(s->GetId()) -
+	  CountBefore(s->GetPlayer()->GetStrategy(1)->GetId()) + 1);
 }
 
 template<>
@@ -84,21 +233,31 @@ MixedStrategyProfile<Rational> StrategySupportProfile::NewMixedStrategyProfile(v
 bool StrategySupportProfile::IsSubsetOf(const StrategySupportProfile &p_support) const
 {
   if (m_nfg != p_support.m_nfg)  return false;
-  for (int pl = 1; pl <= m_support.Length(); pl++) {
-    if (m_support[pl].Length() > p_support.m_support[pl].Length()) {
+  for (size_t word = 0; word < m_members.size(); word++) {
+    if (m_members[word] & ~p_support.m_members[word]) {
       return false;
     }
-    else {
-      for (int st = 1; st <= m_support[pl].Length(); st++) {
-	if (!p_support.m_support[pl].Contains(m_support[pl][st])) {
-	  return false;
-	}
-      }
-    }
   }
   return true;
 }
 
+bool StrategySupportProfile::operator<(const StrategySupportProfile &p_support) const
+{
+  if (m_nfg != p_support.m_nfg) {
+    return (m_nfg.operator->() < p_support.m_nfg.operator->());
+  }
+  return m_members < p_support.m_members;
+}
+
+size_t StrategySupportProfile::Hash(void) const
+{
+  size_t hash = 0;
+  for (size_t word = 0; word < m_members.size(); word++) {
+    hash = hash * 1000003UL ^ (size_t) m_members[word];
+  }
+  return hash;
+}
+
 
 namespace {
 
@@ -157,63 +316,49 @@ void StrategySupportProfile::WriteNfgFile(std::ostream &p_file) const
 //                        Modifying the support
 //---------------------------------------------------------------------------
 
+void StrategySupportProfile::SetMember(int p_id, bool p_member)
+{
+  int word = (p_id - 1) / c_wordBits;
+  unsigned long mask = 1UL << ((p_id - 1) % c_wordBits);
+  if (p_member) {
+    m_members[word] |= mask;
+  }
+  else {
+    m_members[word] &= ~mask;
+  }
+  for (size_t w = word + 1; w < m_ranks.size(); w++) {
+    m_ranks[w] += (p_member) ? 1 : -1;
+  }
+}
+
 void StrategySupportProfile::AddStrategy(const GameStrategy &p_strategy)
 { 
   // Get the null-pointer checking out of the way once and for all
   GameStrategyRep *strategy = p_strategy;
-  Array<GameStrategy> &support = 
-    m_support[strategy->GetPlayer()->GetNumber()];
-  
-
-  for (int i = 1; i <= support.Length(); i++) {
-    GameStrategyRep *s = support[i];
-    if (s->GetNumber() == strategy->GetNumber()) {
-      // Strategy already in support; no change
-      return;
-    }
-    if (s->GetNumber() > strategy->GetNumber()) {
-      // Shift all higher-id strategies by one in the profile
-      m_profileIndex[strategy->GetId()] = m_profileIndex[s->GetId()];
-      for (int id = s->GetId(); id <= m_profileIndex.Length(); id++) {
-	if (m_profileIndex[id] >= 0)  m_profileIndex[id]++;
-      }
-      // Insert here
-      support.Insert(strategy, i);
-      return;
-    }
+  if (ContainsId(strategy->GetId())) {
+    // Strategy already in support; no change
+    return;
   }
 
-  // If we get here, p_strategy has a higher number than anything in the
-  // support for this player; append.
-  GameStrategyRep *last = support[support.Last()];
-  m_profileIndex[strategy->GetId()] = m_profileIndex[last->GetId()] + 1;
-  for (int id = strategy->GetId()+1; id <= m_profileIndex.Length(); id++) {
-    if (m_profileIndex[id] >= 0)  m_profileIndex[id]++;
-  }
-  support.Append(strategy);
+  // The strategies of the player in the support before this one
+  GamePlayerRep *player = strategy->GetPlayer();
+  int before = (CountBefore(strategy->GetId()) -
+		CountBefore(player->GetStrategy(1)->GetId()));
+  m_support[player->GetNumber()].Insert(strategy, before + 1);
+  SetMember(strategy->GetId(), true);
 }
 
 bool StrategySupportProfile::RemoveStrategy(const GameStrategy &p_strategy)
 { 
   GameStrategyRep *strategy = p_strategy;
-  Array<GameStrategy> &support = m_support[strategy->GetPlayer()->GetNumber()];
-
-  if (support.Length() == 1) return false;
-
-  for (int i = 1; i <= support.Length(); i++) {
-    GameStrategyRep *s = support[i];
-    if (s == strategy) {
-      support.Remove(i);
-      m_profileIndex[strategy->GetId()] = -1;
-      // Shift strategies left in the profile
-      for (int id = strategy->GetId()+1; id <= m_profileIndex.Length(); id++) {
-	if (m_profileIndex[id] >= 0)  m_profileIndex[id]--;
-      }
-      return true;
-    }
-  }
+  GamePlayerRep *player = strategy->GetPlayer();
+  Array<GameStrategy> &support = m_support[player->GetNumber()];
 
-  return false;
+  if (support.Length() == 1 || !ContainsId(strategy->GetId())) return false;
+
+  support.Remove(GetIndex(strategy));
+  SetMember(strategy->GetId(), false);
+  return true;
 } 
 
 
@@ -225,21 +370,10 @@ bool StrategySupportProfile::Dominates(const GameStrategy &s,
 				const GameStrategy &t, 
 				bool p_strict) const
 {
-  bool equal = true;
-  
-  for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
-    Rational ap = (*iter)->GetStrategyValue(s);
-    Rational bp = (*iter)->GetStrategyValue(t);
-    if (p_strict && ap <= bp) {
-      return false;
-    }
-    else if (!p_strict) {
-      if (ap < bp) return false;
-      else if (ap > bp) equal = false;
-    }
-  }
-
-  return (p_strict || !equal);
+  Array<GameStrategy> strategies;
+  strategies.Append(s);
+  strategies.Append(t);
+  return StrategyPayoffSlices(*this, strategies).Dominates(1, 2, p_strict);
 }
 
 
@@ -247,118 +381,44 @@ bool StrategySupportProfile::IsDominated(const GameStrategy &s,
 				  bool p_strict,
 				  bool p_external) const
 {
+  GamePlayer player = s->GetPlayer();
+  Array<GameStrategy> strategies;
   if (p_external) {
-    GamePlayer player = s->GetPlayer();
     for (int st = 1; st <= player->NumStrategies(); st++) {
-      if (player->GetStrategy(st) != s &&
-	  Dominates(player->GetStrategy(st), s, p_strict)) {
-	return true;
-      }
+      strategies.Append(player->GetStrategy(st));
     }
-    return false;
   }
   else {
-    for (int i = 1; i <= NumStrategies(s->GetPlayer()->GetNumber()); i++) {
-      if (GetStrategy(s->GetPlayer()->GetNumber(), i) != s &&
-	  Dominates(GetStrategy(s->GetPlayer()->GetNumber(), i), s, 
-		    p_strict)) {
-	return true;
-      }
-    }
-    return false;
+    strategies = Strategies(player);
   }
-}
-
-bool StrategySupportProfile::Undominated(StrategySupportProfile &newS, int p_player,
-				  bool p_strict, bool p_external) const
-{
-  Array<GameStrategy> set((p_external) ? 
-			  m_nfg->GetPlayer(p_player)->NumStrategies() :
-			  NumStrategies(p_player));
-
-  if (p_external) {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = m_nfg->GetPlayer(p_player)->GetStrategy(st);
-    }
-  }
-  else {
-    for (int st = 1; st <= set.Length(); st++) {
-      set[st] = GetStrategy(p_player, st);
-    }
+  if (!strategies.Contains(s)) {
+    strategies.Append(s);
   }
 
-  int min = 0, dis = set.Length() - 1;
-
-  while (min <= dis) {
-    int pp;
-    for (pp = 0;
-	 pp < min && !Dominates(set[pp+1], set[dis+1], p_strict);
-	 pp++);
-    if (pp < min)
-      dis--;
-    else  {
-      GameStrategy foo = set[dis+1];
-      set[dis+1] = set[min+1];
-      set[min+1] = foo;
-
-      for (int inc = min + 1; inc <= dis; )  {
-	if (Dominates(set[min+1], set[dis+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[dis+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[min+1])->GetNumber() << '\n';
-	  dis--;
-	}
-	else if (Dominates(set[dis+1], set[min+1], p_strict)) {
-	  //p_tracefile << GetStrategy(p_player, set[min+1])->GetNumber() << " dominated by " << GetStrategy(p_player, set[dis+1])->GetNumber() << '\n';
-	  foo = set[dis+1];
-	  set[dis+1] = set[min+1];
-	  set[min+1] = foo;
-	  dis--;
-	}
-	else  {
-	  foo = set[dis+1];
-	  set[dis+1] = set[inc+1];
-	  set[inc+1] = foo;
-	  inc++;
-	}
-      }
-      min++;
-    }
-  }
-    
-  if (min + 1 <= set.Length()) {
-    for (int i = min + 1; i <= set.Length(); i++) {
-      newS.RemoveStrategy(set[i]);
+  StrategyPayoffSlices slices(*this, strategies);
+  int t = slices.Find(s);
+  for (int st = 1; st <= slices.NumStrategies(); st++) {
+    if (st != t && slices.Dominates(st, t, p_strict)) {
+      return true;
     }
-    
-    return true;
-  }
-  else {
-    return false;
   }
+  return false;
 }
 
 StrategySupportProfile StrategySupportProfile::Undominated(bool p_strict,
 					     bool p_external) const
 {
-  StrategySupportProfile newS(*this);
-
-  for (int pl = 1; pl <= m_nfg->NumPlayers(); pl++)   {
-    Undominated(newS, pl, p_strict, p_external);
-  }
-
-  return newS;
+  IteratedDominance elimination(*this, p_strict, p_external);
+  elimination.NextLevel();
+  return elimination.GetSupport();
 }
 
 StrategySupportProfile
 StrategySupportProfile::Undominated(bool p_strict, const Array<int> &players) const
 {
-  StrategySupportProfile newS(*this);
-  
-  for (int i = 1; i <= players.Length(); i++)   {
-    //tracefile << "Dominated strategies for player " << pl << ":\n";
-    Undominated(newS, players[i], p_strict);
-  }
-
-  return newS;
+  IteratedDominance elimination(*this, p_strict);
+  elimination.NextLevel(players);
+  return elimination.GetSupport();
 }
 
 //---------------------------------------------------------------------------
@@ -369,7 +429,7 @@ bool StrategySupportProfile::Overwhelms(const GameStrategy &s,
 					const GameStrategy &t, 
 					bool p_strict) const
 {
-  StrategyProfileIterator iter(*this);
+  StrategyProfileIterator iter(*this, true);
   Rational sMin = (*iter)->GetStrategyValue(s);
   Rational tMax = (*iter)->GetStrategyValue(t);
 
@@ -395,13 +455,15 @@ Game StrategySupportProfile::Restrict(void) const
   std::ostringstream os;
   WriteNfgFile(os);
   std::istringstream is(os.str());
-  Game restricted = ReadGame(is);
+  // Restrictions of numeric games are also numeric
+  const GameTableRep *table = dynamic_cast<const GameTableRep *>((GameRep *) m_nfg);
+  Game restricted = ReadGame(is, table && table->IsNumeric());
   for (int pl = 1; pl <= restricted->NumPlayers(); pl++) {
     GamePlayerRep *player = restricted->Players()[pl];
     player->m_unrestricted = m_nfg->Players()[pl];
     for (int st = 1; st <= player->NumStrategies(); st++) {
       GameStrategyRep *strategy = player->m_strategies[st];
-      strategy->m_unrestricted = m_nfg->Players()[pl]->Strategies()[st];
+      strategy->m_unrestricted = GetStrategy(pl, st);
     }
   }
   dynamic_cast<GameTableRep &>(*restricted).m_unrestricted = m_nfg;
@@ -444,6 +506,382 @@ StrategySupportProfile::iterator::IsSubsequentTo(const GameStrategy &s) const
       return false;
 }
 
+//===========================================================================
+//                        class StrategyPayoffSlices
+//===========================================================================
+
+StrategyPayoffSlices::StrategyPayoffSlices(const StrategySupportProfile &p_support,
+					   const Array<GameStrategy> &p_strategies)
+  : m_player(p_strategies[1]->GetPlayer()->GetNumber()),
+    m_strategies(p_strategies),
+    m_positions(p_strategies[1]->GetPlayer()->NumStrategies()),
+    m_strides(p_support.NumPlayers()),
+    m_values(p_strategies.Length()), m_exact(p_strategies.Length()),
+    m_witnesses(p_strategies.Length() * p_strategies.Length(), -1L)
+{
+  Game game = p_support.GetGame();
+  long stride = 1L;
+  for (int pl = 1; pl <= m_strides.Length(); pl++) {
+    m_strides[pl] = stride;
+    stride *= game->GetPlayer(pl)->NumStrategies();
+  }
+  for (int st = 1; st <= m_positions.Length(); m_positions[st++] = 0);
+  for (int st = 1; st <= m_strategies.Length(); st++) {
+    m_positions[m_strategies[st]->GetNumber()] = st;
+  }
+
+  GetKeys(p_support, m_keys);
+  long numProfiles = m_keys.size();
+  for (int st = 1; st <= m_strategies.Length(); st++) {
+    m_values[st - 1].resize(numProfiles);
+    m_exact[st - 1].resize(numProfiles);
+  }
+
+  const GameTableRep *table = 
+    dynamic_cast<const GameTableRep *>(game.operator->());
+  if (table) {
+    for (int st = 1; st <= m_strategies.Length(); st++) {
+      long offset = (m_strategies[st]->GetNumber() - 1) * m_strides[m_player] + 1;
+      for (long k = 0; k < numProfiles; k++) {
+	m_values[st - 1][k] = table->GetPayoff<double>(m_keys[k] + offset, m_player);
+	m_exact[st - 1][k] = &table->GetPayoff<Rational>(m_keys[k] + offset, m_player);
+      }
+    }
+  }
+  else {
+    m_payoffs.reserve(numProfiles * m_strategies.Length());
+    PureStrategyProfile profile = game->NewPureStrategyProfile();
+    for (long k = 0; k < numProfiles; k++) {
+      for (int pl = 1; pl <= m_strides.Length(); pl++) {
+	if (pl != m_player) {
+	  GamePlayer player = game->GetPlayer(pl);
+	  int st = (m_keys[k] / m_strides[pl]) % player->NumStrategies() + 1;
+	  profile->SetStrategy(player->GetStrategy(st));
+	}
+      }
+      for (int st = 1; st <= m_strategies.Length(); st++) {
+	m_payoffs.push_back(profile->GetStrategyValue(m_strategies[st]));
+	m_exact[st - 1][k] = &m_payoffs.back();
+	m_values[st - 1][k] = (double) m_payoffs.back();
+      }
+    }
+  }
+  ComputeBounds();
+}
+
+void StrategyPayoffSlices::GetKeys(const StrategySupportProfile &p_support,
+				   std::vector<long> &p_keys) const
+{
+  p_keys.clear();
+  int numPlayers = m_strides.Length();
+  Array<int> current(numPlayers);
+  long key = 0L;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    current[pl] = 1;
+    if (pl != m_player) {
+      key += (p_support.GetStrategy(pl, 1)->GetNumber() - 1) * m_strides[pl];
+    }
+  }
+
+  while (true) {
+    p_keys.push_back(key);
+    int pl = 1;
+    for (; pl <= numPlayers; pl++) {
+      if (pl == m_player) continue;
+      key -= (p_support.GetStrategy(pl, current[pl])->GetNumber() - 1) * m_strides[pl];
+      current[pl] = (current[pl] < p_support.NumStrategies(pl)) ? current[pl] + 1 : 1;
+      key += (p_support.GetStrategy(pl, current[pl])->GetNumber() - 1) * m_strides[pl];
+      if (current[pl] > 1) break;
+    }
+    if (pl > numPlayers) return;
+  }
+}
+
+void StrategyPayoffSlices::ComputeBounds(void)
+{
+  m_least.resize(m_values.size());
+  m_greatest.resize(m_values.size());
+  for (size_t st = 0; st < m_values.size(); st++) {
+    const std::vector<double> &values = m_values[st];
+    m_least[st] = *std::min_element(values.begin(), values.end());
+    m_greatest[st] = *std::max_element(values.begin(), values.end());
+  }
+}
+
+int StrategyPayoffSlices::Compare(int s, int t, long p_profile) const
+{
+  double a = m_values[s - 1][p_profile], b = m_values[t - 1][p_profile];
+  if (IsClearlyLess(a, b)) {
+    return -1;
+  }
+  else if (IsClearlyLess(b, a)) {
+    return 1;
+  }
+  const Rational &x = *m_exact[s - 1][p_profile];
+  const Rational &y = *m_exact[t - 1][p_profile];
+  return (x < y) ? -1 : ((y < x) ? 1 : 0);
+}
+
+bool StrategyPayoffSlices::Dominates(int s, int t, bool p_strict)
+{
+  // Strategy s fails to dominate t at any profile where the comparison
+  // of their payoffs is no more than this
+  int fails = (p_strict) ? 0 : -1;
+  long &witness = m_witnesses[(s - 1) * m_strategies.Length() + t - 1];
+  if (witness >= 0 && Compare(s, t, witness) <= fails) {
+    return false;
+  }
+  // If s dominates t, its least and greatest payoffs are no less than
+  // those of t
+  if (IsClearlyLess(m_least[s - 1], m_least[t - 1]) ||
+      IsClearlyLess(m_greatest[s - 1], m_greatest[t - 1])) {
+    return false;
+  }
+
+  bool better = p_strict;
+  for (long k = 0; k < (long) m_keys.size(); k++) {
+    int comparison = Compare(s, t, k);
+    if (comparison <= fails) {
+      witness = k;
+      return false;
+    }
+    better = better || (comparison > 0);
+  }
+  return better;
+}
+
+namespace {
+
+//
+// Returns the optimal value of the linear program of maximizing c x
+// subject to A x <= b and x >= 0, for b >= 0, so that x = 0 is feasible
+// and the value is at least zero; the value is negative if the program
+// is unbounded or could not be solved.
+//
+template <class T>
+T MaximizeValue(const Matrix<T> &A, const Vector<T> &b, const Vector<T> &c)
+{
+  linalg::LPSolve<T> lp(A, b, c, 0);
+  if (!lp.IsWellFormed() || !lp.IsFeasible() || !lp.IsBounded()) {
+    return (T) -1;
+  }
+  const linalg::BFS<T> &optimum = lp.OptimumBFS();
+  T value = (T) 0;
+  for (int j = 1; j <= c.Length(); j++) {
+    if (optimum.count(j)) {
+      value += c[j] * optimum[j];
+    }
+  }
+  return value;
+}
+
+}  // end anonymous namespace
+
+//
+// With payoffs shifted to be positive, strategy t is strictly dominated
+// by a mixture of the strategies exactly when some nonnegative weights,
+// summing to less than one, give each profile a weighted payoff at least
+// that of t.  By duality, this is when the value of
+//   maximize u_t y  subject to  u_s y <= 1 for all strategies s,  y >= 0
+// is less than one, where y has a component for each profile.  Including
+// t among the strategies s keeps the value at most one.  The program is
+// first solved with doubles; only if this finds t dominated is it solved
+// again exactly.
+//
+bool StrategyPayoffSlices::IsMixedDominated(int t,
+					    const Array<int> &p_strategies) const
+{
+  // Dominance by a mixture of one other strategy is pure dominance
+  if (p_strategies.Length() < 3) {
+    return false;
+  }
+
+  long numProfiles = m_keys.size();
+  double least = m_least[t - 1];
+  for (int i = 1; i <= p_strategies.Length(); i++) {
+    least = std::min(least, m_least[p_strategies[i] - 1]);
+  }
+  // An integer shift, so that the exact payoffs are also positive
+  long shift = 2L - (long) std::floor(least);
+
+  Matrix<double> A(1, p_strategies.Length(), 1, numProfiles);
+  Vector<double> b(1, p_strategies.Length()), c(1, numProfiles);
+  for (int i = 1; i <= p_strategies.Length(); i++) {
+    const std::vector<double> &values = m_values[p_strategies[i] - 1];
+    for (long k = 0; k < numProfiles; k++) {
+      A(i, k + 1) = values[k] + shift;
+    }
+  }
+  for (long k = 0; k < numProfiles; k++) {
+    c[k + 1] = m_values[t - 1][k] + shift;
+  }
+  b = 1.0;
+  double value = MaximizeValue(A, b, c);
+  if (value < 0.0 || value > 1.0 - c_tolerance * 1.0e3) {
+    return false;
+  }
+
+  Matrix<Rational> exactA(1, p_strategies.Length(), 1, numProfiles);
+  Vector<Rational> exactB(1, p_strategies.Length()), exactC(1, numProfiles);
+  Rational exactShift(shift);
+  for (int i = 1; i <= p_strategies.Length(); i++) {
+    const std::vector<const Rational *> &payoffs = m_exact[p_strategies[i] - 1];
+    for (long k = 0; k < numProfiles; k++) {
+      exactA(i, k + 1) = *payoffs[k] + exactShift;
+    }
+  }
+  for (long k = 0; k < numProfiles; k++) {
+    exactC[k + 1] = *m_exact[t - 1][k] + exactShift;
+  }
+  exactB = Rational(1);
+  Rational exactValue = MaximizeValue(exactA, exactB, exactC);
+  return (exactValue >= Rational(0) && exactValue < Rational(1));
+}
+
+void StrategyPayoffSlices::Restrict(const StrategySupportProfile &p_support)
+{
+  long numProfiles = 1L;
+  for (int pl = 1; pl <= m_strides.Length(); pl++) {
+    if (pl != m_player) {
+      numProfiles *= p_support.NumStrategies(pl);
+    }
+  }
+  if (numProfiles == (long) m_keys.size()) {
+    return;
+  }
+
+  // The profiles in the support are a subsequence of those held, so
+  // each can be moved down into its new position
+  std::vector<long> keys;
+  GetKeys(p_support, keys);
+  std::vector<long> positions(m_keys.size(), -1L);
+  long k = 0;
+  for (long j = 0; j < (long) keys.size(); j++, k++) {
+    while (m_keys[k] != keys[j]) k++;
+    positions[k] = j;
+    for (size_t st = 0; st < m_values.size(); st++) {
+      m_values[st][j] = m_values[st][k];
+      m_exact[st][j] = m_exact[st][k];
+    }
+  }
+  for (size_t st = 0; st < m_values.size(); st++) {
+    m_values[st].resize(keys.size());
+    m_exact[st].resize(keys.size());
+  }
+  m_keys.swap(keys);
+
+  for (size_t i = 0; i < m_witnesses.size(); i++) {
+    if (m_witnesses[i] >= 0) {
+      m_witnesses[i] = positions[m_witnesses[i]];
+    }
+  }
+  ComputeBounds();
+}
+
+//===========================================================================
+//                         class IteratedDominance
+//===========================================================================
+
+IteratedDominance::IteratedDominance(const StrategySupportProfile &p_support,
+				     bool p_strict, bool p_external,
+				     int p_numThreads)
+  : m_support(p_support), m_strict(p_strict), m_external(p_external),
+    m_mixed(false), m_numThreads(p_numThreads),
+    m_slices(p_support.NumPlayers())
+{
+  for (int pl = 1; pl <= m_slices.Length(); m_slices[pl++] = 0);
+}
+
+IteratedDominance::~IteratedDominance()
+{
+  for (int pl = 1; pl <= m_slices.Length(); delete m_slices[pl++]);
+}
 
+bool IteratedDominance::NextLevel(void)
+{
+  Array<int> players(m_support.NumPlayers());
+  for (int pl = 1; pl <= players.Length(); pl++) {
+    players[pl] = pl;
+  }
+  return NextLevel(players);
+}
+
+bool IteratedDominance::NextLevel(const Array<int> &p_players)
+{
+#ifdef GAMBIT_THREADS
+  int numThreads = std::max(1, m_numThreads);
+#else
+  int numThreads = 1;
+#endif  // GAMBIT_THREADS
+  if (numThreads > 1) {
+    m_support.GetGame()->PrepareForSharing();
+  }
+
+  // The dominated strategies of all the players are found in the
+  // current support, before any are eliminated
+  List<GameStrategy> dominated;
+  for (int i = 1; i <= p_players.Length(); i++) {
+    GamePlayer player = m_support.GetGame()->GetPlayer(p_players[i]);
+    if (m_support.NumStrategies(player->GetNumber()) == 1) {
+      continue;
+    }
+    if (!m_slices[player->GetNumber()]) {
+      Array<GameStrategy> strategies;
+      if (m_external) {
+	for (int st = 1; st <= player->NumStrategies(); st++) {
+	  strategies.Append(player->GetStrategy(st));
+	}
+      }
+      else {
+	strategies = m_support.Strategies(player);
+      }
+      m_slices[player->GetNumber()] = new StrategyPayoffSlices(m_support, 
+							       strategies);
+    }
+    StrategyPayoffSlices &slices = *m_slices[player->GetNumber()];
+
+    Array<int> dominators, candidates;
+    for (int st = 1; st <= slices.NumStrategies(); st++) {
+      if (m_external || m_support.Contains(slices.GetStrategy(st))) {
+	dominators.Append(st);
+      }
+    }
+    for (int st = 1; st <= m_support.NumStrategies(player->GetNumber()); st++) {
+      candidates.Append(slices.Find(m_support.GetStrategy(player->GetNumber(), st)));
+    }
+    int numTasks = std::min(numThreads, candidates.Length());
+    Array<long> bounds = SplitContingencies(candidates.Length(), numTasks);
+    std::vector<char> isDominated(candidates.Length(), 0);
+    Array<ParallelTask *> tasks(numTasks);
+    for (int j = 1; j <= numTasks; j++) {
+      tasks[j] = new DominanceTask(slices, dominators, candidates,
+				   m_strict, m_mixed,
+				   bounds[j], bounds[j + 1], isDominated);
+    }
+    RunParallelTasks(tasks);
+    for (int j = 1; j <= numTasks; j++) {
+      delete tasks[j];
+    }
+
+    for (int j = 1; j <= candidates.Length(); j++) {
+      if (isDominated[j - 1]) {
+	dominated.Append(slices.GetStrategy(candidates[j]));
+      }
+    }
+  }
+
+  bool eliminated = false;
+  for (int i = 1; i <= dominated.Length(); i++) {
+    eliminated = m_support.RemoveStrategy(dominated[i]) || eliminated;
+  }
+  if (eliminated) {
+    for (int pl = 1; pl <= m_slices.Length(); pl++) {
+      if (m_slices[pl]) {
+	m_slices[pl]->Restrict(m_support);
+      }
+    }
+  }
+  return eliminated;
+}
 
 } // end namespace Gambit
@@ -0,0 +1,70 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/threads.cc
+// Running parts of a computation in separate threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifdef GAMBIT_THREADS
+#include <pthread.h>
+#endif  // GAMBIT_THREADS
+
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+#ifdef GAMBIT_THREADS
+namespace {
+
+void *RunParallelTask(void *p_task)
+{
+  static_cast<ParallelTask *>(p_task)->Run();
+  return 0;
+}
+
+}  // end anonymous namespace
+#endif  // GAMBIT_THREADS
+
+void RunParallelTasks(const Array<ParallelTask *> &p_tasks)
+{
+#ifdef GAMBIT_THREADS
+  Array<pthread_t> threads(p_tasks.Length());
+  Array<bool> started(p_tasks.Length());
+  for (int i = 2; i <= p_tasks.Length(); i++) {
+    started[i] = (pthread_create(&threads[i], 0, RunParallelTask,
+				 p_tasks[i]) == 0);
+  }
+  if (p_tasks.Length() > 0) {
+    p_tasks[1]->Run();
+  }
+  for (int i = 2; i <= p_tasks.Length(); i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+    else {
+      p_tasks[i]->Run();
+    }
+  }
+#else
+  for (int i = 1; i <= p_tasks.Length(); i++) {
+    p_tasks[i]->Run();
+  }
+#endif  // GAMBIT_THREADS
+}
+
+} // end namespace Gambit
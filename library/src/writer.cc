@@ -21,6 +21,7 @@
 //
 
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/writer.h"
 
 using namespace Gambit;
@@ -177,3 +178,129 @@ std::string LaTeXGameWriter::Write(const Game &p_game,
   return theHtml;
 }
 
+
+//=========================================================================
+//                      Binary strategic game format
+//=========================================================================
+
+namespace {
+
+bool IsLittleEndian(void)
+{
+  unsigned int one = 1;
+  return *((unsigned char *) &one) == 1;
+}
+
+void AppendInteger(std::string &p_data, unsigned int p_value)
+{
+  for (int i = 0; i < 4; i++) {
+    p_data += (char) ((p_value >> (8 * i)) & 0xff);
+  }
+}
+
+void AppendString(std::string &p_data, const std::string &p_value)
+{
+  AppendInteger(p_data, p_value.length());
+  p_data += p_value;
+}
+
+void AppendDoubles(std::string &p_data, const double *p_values, long p_count)
+{
+  const char *bytes = (const char *) p_values;
+  if (IsLittleEndian()) {
+    p_data.append(bytes, p_count * sizeof(double));
+    return;
+  }
+  for (long i = 0; i < p_count; i++, bytes += sizeof(double)) {
+    for (int j = sizeof(double) - 1; j >= 0; p_data += bytes[j--]);
+  }
+}
+
+// Returns the payoff as a double, throwing if that is not exact
+double ExactDouble(const Rational &p_payoff)
+{
+  double value = (double) p_payoff;
+  if (Rational(value) != p_payoff) {
+    throw UndefinedException("The payoff " + lexical_cast<std::string>(p_payoff) +
+			     " cannot be stored exactly in the binary format");
+  }
+  return value;
+}
+
+} // end anonymous namespace
+
+const char NfgBinaryGameWriter::Magic[8] = 
+  { '\211', 'N', 'F', 'G', 'B', '\r', '\n', '\032' };
+
+std::string NfgBinaryGameWriter::Write(const Game &p_game) const
+{
+  std::string data(Magic, 8);
+  AppendInteger(data, Version);
+  AppendInteger(data, p_game->NumPlayers());
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    AppendInteger(data, p_game->GetPlayer(pl)->NumStrategies());
+  }
+
+  AppendString(data, p_game->GetTitle());
+  AppendString(data, p_game->GetComment());
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    AppendString(data, p_game->GetPlayer(pl)->GetLabel());
+  }
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      AppendString(data, player->GetStrategy(st)->GetLabel());
+    }
+  }
+
+  const GameTableRep *table = 
+    dynamic_cast<const GameTableRep *>((GameRep *) p_game);
+  if (table) {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      const Array<double> &payoffs = table->GetPayoffTable<double>(pl);
+      if (!table->IsNumeric()) {
+	// The exact payoffs must survive the trip through doubles
+	const Array<Rational> &exact = table->GetPayoffTable<Rational>(pl);
+	for (long cont = 1; cont <= exact.Length(); ExactDouble(exact[cont++]));
+      }
+      if (payoffs.Length() > 0) {
+	AppendDoubles(data, &payoffs[1], payoffs.Length());
+      }
+    }
+    return data;
+  }
+
+  // Other representations are evaluated contingency by contingency,
+  // with the first player's strategy varying fastest
+  long ncont = p_game->NumStrategyContingencies();
+  Array<Array<double> > payoffs(p_game->NumPlayers());
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    payoffs[pl] = Array<double>(ncont);
+  }
+  PureStrategyProfile profile = p_game->NewPureStrategyProfile();
+  Array<int> strategies(p_game->NumPlayers());
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    strategies[pl] = 1;
+    profile->SetStrategy(p_game->GetPlayer(pl)->GetStrategy(1));
+  }
+  for (long cont = 1; cont <= ncont; cont++) {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      payoffs[pl][cont] = ExactDouble(profile->GetPayoff(pl));
+    }
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      GamePlayer player = p_game->GetPlayer(pl);
+      if (strategies[pl] < player->NumStrategies()) {
+	profile->SetStrategy(player->GetStrategy(++strategies[pl]));
+	break;
+      }
+      strategies[pl] = 1;
+      profile->SetStrategy(player->GetStrategy(1));
+    }
+  }
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    if (ncont > 0) {
+      AppendDoubles(data, &payoffs[pl][1], ncont);
+    }
+  }
+  return data;
+}
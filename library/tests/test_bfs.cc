@@ -0,0 +1,145 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_bfs.cc
+// Checks of basic feasible solutions and sets of them
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include "gambit/gambit.h"
+#include "gambit/linalg/bfs.h"
+
+using namespace Gambit;
+using namespace Gambit::linalg;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+unsigned long seed = 12345UL;
+
+int Random(int p_range)
+{
+  seed = seed * 1103515245UL + 12345UL;
+  return (seed >> 16) % p_range;
+}
+
+//
+// A basis of keys from -20 to 20, as the solvers use negative keys for
+// some variables
+//
+std::vector<int> RandomBasis(void)
+{
+  std::set<int> keys;
+  int size = 1 + Random(8);
+  while ((int) keys.size() < size) {
+    keys.insert(Random(41) - 20);
+  }
+  return std::vector<int>(keys.begin(), keys.end());
+}
+
+//
+// The BFS with the basis, inserting the keys in a shuffled order, with
+// the values given by p_offset
+//
+BFS<Rational> MakeBFS(const std::vector<int> &p_basis, int p_offset)
+{
+  std::vector<int> keys(p_basis);
+  for (size_t i = keys.size(); i > 1; i--) {
+    std::swap(keys[i - 1], keys[Random(i)]);
+  }
+  BFS<Rational> bfs;
+  for (size_t i = 0; i < keys.size(); i++) {
+    bfs.insert(keys[i], Rational(keys[i] + p_offset));
+  }
+  return bfs;
+}
+
+void CheckBFS(const std::vector<int> &p_basis)
+{
+  BFS<Rational> first = MakeBFS(p_basis, 0);
+  BFS<Rational> second = MakeBFS(p_basis, 100);
+  Check(first == second, "BFS's with the same basis are unequal");
+  Check(first.Hash() == second.Hash(),
+	"BFS's with the same basis hash differently");
+
+  for (int key = -21; key <= 21; key++) {
+    bool member = std::binary_search(p_basis.begin(), p_basis.end(), key);
+    Check(first.count(key) == ((member) ? 1 : 0), "count() differs");
+    Check(first[key] == ((member) ? Rational(key) : Rational(0)),
+	  "value differs");
+  }
+
+  // Inserting a key again replaces its value, without changing the basis
+  int key = p_basis[Random(p_basis.size())];
+  first.insert(key, Rational(1, 3));
+  Check(first[key] == Rational(1, 3), "value not replaced");
+  Check(first == second && first.Hash() == second.Hash(),
+	"replacing a value changed the basis");
+
+  // Inserting a new key changes the basis
+  int extra = 21;
+  second.insert(extra, Rational(1));
+  Check(first != second, "BFS's with different bases are equal");
+}
+
+} // end anonymous namespace
+
+int main(void)
+{
+  std::set<std::vector<int> > expected;
+  std::vector<std::vector<int> > bases;
+  BFSSet<Rational> set;
+  Check(!set.Contains(BFS<Rational>()), "empty set has a member");
+
+  // Enough bases to rehash the set several times
+  for (int i = 0; i < 500; i++) {
+    std::vector<int> basis = RandomBasis();
+    CheckBFS(basis);
+    bool added = expected.insert(basis).second;
+    Check(set.insert(MakeBFS(basis, i)) == added,
+	  "insertion into set reported wrongly");
+    Check(set.size() == (int) expected.size(), "set has wrong size");
+    bases.push_back(basis);
+  }
+  Check(set.size() > 100, "too few different bases to rehash");
+
+  for (size_t i = 0; i < bases.size(); i++) {
+    Check(set.Contains(MakeBFS(bases[i], -1)), "member of set not found");
+    Check(!set.insert(MakeBFS(bases[i], 1)), "member of set inserted again");
+  }
+  for (int i = 0; i < 500; i++) {
+    std::vector<int> basis = RandomBasis();
+    Check(set.Contains(MakeBFS(basis, 0)) == (expected.count(basis) > 0),
+	  "membership in set differs");
+  }
+  Check(set.size() == (int) expected.size(), "set has wrong size at end");
+
+  return (failures > 0) ? 1 : 0;
+}
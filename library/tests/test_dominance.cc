@@ -0,0 +1,252 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_dominance.cc
+// Checks of the elimination of dominated strategies
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/nash.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+std::string ToText(long p_value)
+{
+  std::ostringstream s;
+  s << p_value;
+  return s.str();
+}
+
+//
+// A table with small pseudo-random integer payoffs, so that there are
+// ties, tilted towards each player's later strategies, so that there
+// are dominated strategies even with several opponents
+//
+Game RandomTable(const Array<int> &p_dim, unsigned long p_seed)
+{
+  Game game = NewTable(p_dim);
+  for (StrategyProfileIterator iter(game); !iter.AtEnd(); iter++) {
+    GameOutcome outcome = (*iter)->GetOutcome();
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      p_seed = p_seed * 1103515245UL + 12345UL;
+      outcome->SetPayoff(pl, ToText((p_seed >> 16) % 4 +
+				    (*iter)->GetStrategy(pl)->GetNumber()));
+    }
+  }
+  return game;
+}
+
+//
+// Whether s dominates t, found by comparing their values on each
+// profile of the support in turn
+//
+bool Dominates(const StrategySupportProfile &p_support,
+	       const GameStrategy &s, const GameStrategy &t, bool p_strict)
+{
+  bool better = false;
+  for (StrategyProfileIterator iter(p_support); !iter.AtEnd(); iter++) {
+    Rational sValue = (*iter)->GetStrategyValue(s);
+    Rational tValue = (*iter)->GetStrategyValue(t);
+    if (sValue < tValue || (p_strict && sValue == tValue)) {
+      return false;
+    }
+    better = better || sValue > tValue;
+  }
+  return better;
+}
+
+//
+// One level of elimination by pure strategies, found by comparing each
+// pair of strategies with Dominates() above
+//
+StrategySupportProfile NextLevel(const StrategySupportProfile &p_support,
+				 bool p_strict, bool p_external)
+{
+  Game game = p_support.GetGame();
+  List<GameStrategy> dominated;
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    if (p_support.NumStrategies(pl) == 1) {
+      continue;
+    }
+    for (int st = 1; st <= p_support.NumStrategies(pl); st++) {
+      GameStrategy t = p_support.GetStrategy(pl, st);
+      for (int i = 1; i <= player->NumStrategies(); i++) {
+	GameStrategy s = player->GetStrategy(i);
+	if (s != t && (p_external || p_support.Contains(s)) &&
+	    Dominates(p_support, s, t, p_strict)) {
+	  dominated.Append(t);
+	  break;
+	}
+      }
+    }
+  }
+  StrategySupportProfile next(p_support);
+  for (int i = 1; i <= dominated.Length(); i++) {
+    next.RemoveStrategy(dominated[i]);
+  }
+  return next;
+}
+
+void CheckPairs(const StrategySupportProfile &p_support, bool p_strict,
+		const std::string &p_name)
+{
+  Game game = p_support.GetGame();
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    for (int st = 1; st <= p_support.NumStrategies(pl); st++) {
+      GameStrategy t = p_support.GetStrategy(pl, st);
+      bool dominated = false;
+      for (int i = 1; i <= p_support.NumStrategies(pl); i++) {
+	GameStrategy s = p_support.GetStrategy(pl, i);
+	bool expected = (s != t && Dominates(p_support, s, t, p_strict));
+	Check(s == t || p_support.Dominates(s, t, p_strict) == expected,
+	      p_name + ": Dominates() differs");
+	dominated = dominated || expected;
+      }
+      Check(p_support.IsDominated(t, p_strict) == dominated,
+	    p_name + ": IsDominated() differs");
+    }
+  }
+}
+
+//
+// Eliminates levels from the game, checking each level against the
+// elimination by NextLevel() above, for each number of threads
+//
+void CheckElimination(const Game &p_game, bool p_strict, bool p_external,
+		      const std::string &p_name)
+{
+  StrategySupportProfile full(p_game);
+  CheckPairs(full, p_strict, p_name);
+  Check(full.Undominated(p_strict, p_external) ==
+	NextLevel(full, p_strict, p_external),
+	p_name + ": Undominated() differs");
+
+  for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+    std::string name = p_name + " with " + ToText(numThreads) + " thread(s)";
+    IteratedDominance elimination(full, p_strict, p_external, numThreads);
+    StrategySupportProfile expected(full);
+    for (int level = 1; ; level++) {
+      StrategySupportProfile next = NextLevel(expected, p_strict, p_external);
+      bool eliminated = elimination.NextLevel();
+      Check(eliminated == (next != expected),
+	    name + ": level " + ToText(level) + " reported wrongly");
+      Check(elimination.GetSupport() == next,
+	    name + ": level " + ToText(level) + " differs");
+      if (!eliminated || next == expected) {
+	break;
+      }
+      expected = next;
+    }
+  }
+}
+
+//
+// A game in which the third strategy of the first player is dominated
+// by an even mixture of the first two, but by neither of them alone,
+// when p_value is less than 3/2
+//
+Game MixtureGame(const std::string &p_value)
+{
+  Array<int> dim(2);
+  dim[1] = 3;  dim[2] = 2;
+  Game game = NewTable(dim);
+  const char *payoffs[3][2][2] = { { { "3", "1" }, { "0", "0" } },
+				   { { "0", "0" }, { "3", "1" } },
+				   { { "", "1" }, { "", "0" } } };
+  for (StrategyProfileIterator iter(game); !iter.AtEnd(); iter++) {
+    int row = (*iter)->GetStrategy(1)->GetNumber();
+    int col = (*iter)->GetStrategy(2)->GetNumber();
+    GameOutcome outcome = (*iter)->GetOutcome();
+    outcome->SetPayoff(1, (row == 3) ? p_value : payoffs[row - 1][col - 1][0]);
+    outcome->SetPayoff(2, payoffs[row - 1][col - 1][1]);
+  }
+  return game;
+}
+
+void CheckMixed(const std::string &p_value, bool p_dominated)
+{
+  std::string name = "mixture game with payoff " + p_value;
+  Game game = MixtureGame(p_value);
+  StrategySupportProfile full(game);
+
+  for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+    IteratedDominance pure(full, true, false, numThreads);
+    pure.EliminateAll();
+    Check(pure.GetSupport() == full,
+	  name + ": eliminated a strategy without mixtures");
+
+    IteratedDominance mixed(full, true, false, numThreads);
+    mixed.SetMixed(true);
+    mixed.EliminateAll();
+    StrategySupportProfile expected(full);
+    if (p_dominated) {
+      expected.RemoveStrategy(game->GetPlayer(1)->GetStrategy(3));
+    }
+    Check(mixed.GetSupport() == expected,
+	  name + ": elimination by mixtures differs");
+  }
+
+  Game reduced = Nash::EliminateDominatedStrategies(game);
+  Check(reduced->GetPlayer(1)->NumStrategies() == ((p_dominated) ? 2 : 3),
+	name + ": reduced game differs");
+}
+
+} // end anonymous namespace
+
+int main(void)
+{
+  for (unsigned long seed = 1; seed <= 6; seed++) {
+    Array<int> dim((seed % 2 == 0) ? 2 : 3);
+    for (int pl = 1; pl <= dim.Length(); pl++) {
+      dim[pl] = 2 + (seed + pl) % 4;
+    }
+    Game game = RandomTable(dim, seed);
+    std::string name = "random game " + ToText(seed);
+    CheckElimination(game, true, false, name + " (strict)");
+    CheckElimination(game, false, false, name + " (weak)");
+
+    // External dominance compares with strategies outside the support
+    StrategySupportProfile support(game);
+    support.RemoveStrategy(game->GetPlayer(1)->GetStrategy(1));
+    Check(support.Undominated(false, true) == NextLevel(support, false, true),
+	  name + ": Undominated() with external strategies differs");
+  }
+
+  CheckMixed("1", true);
+  CheckMixed("7/5", true);
+  CheckMixed("3/2", false);
+  CheckMixed("2", false);
+
+  return (failures > 0) ? 1 : 0;
+}
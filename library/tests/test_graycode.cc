@@ -0,0 +1,124 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_graycode.cc
+// Checks of the Gray-code order of StrategyProfileIterator
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <set>
+#include <cstdlib>
+
+#include "gambit/gambit.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+//
+// Iterates over the support, checking that each contingency is visited
+// once, that the profile agrees with the iterator, and, in Gray-code
+// order, that consecutive contingencies differ by one step of one
+// player's strategy.
+//
+void CheckIteration(const StrategySupportProfile &p_support,
+		    StrategyProfileIterator &p_iter, bool p_grayCode,
+		    long p_count, const std::string &p_name)
+{
+  int numPlayers = p_support.NumPlayers();
+  std::set<long> visited;
+  Array<int> previous(numPlayers);
+  bool first = true;
+  for (; !p_iter.AtEnd(); p_iter++) {
+    Check(visited.insert(p_iter.GetIndex()).second,
+	  p_name + ": contingency visited twice");
+    Check((*p_iter)->GetIndex() == p_iter.GetIndex(),
+	  p_name + ": profile index differs from iterator index");
+    int changed = 0;
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      int st = p_iter.GetStrategyIndex(pl);
+      Check((*p_iter)->GetStrategy(pl) == p_support.GetStrategy(pl, st),
+	    p_name + ": profile strategy differs from iterator strategy");
+      if (!first && st != previous[pl]) {
+	changed++;
+	if (p_grayCode) {
+	  Check(std::abs(st - previous[pl]) == 1,
+		p_name + ": strategy moved by more than one step");
+	}
+      }
+      previous[pl] = st;
+    }
+    if (p_grayCode && !first) {
+      Check(changed == 1, p_name + ": not exactly one strategy changed");
+    }
+    first = false;
+  }
+  Check((long) visited.size() == p_count,
+	p_name + ": wrong number of contingencies visited");
+}
+
+void CheckSupport(const StrategySupportProfile &p_support,
+		  const std::string &p_name)
+{
+  long count = 1L;
+  for (int pl = 1; pl <= p_support.NumPlayers(); pl++) {
+    count *= p_support.NumStrategies(pl);
+  }
+
+  StrategyProfileIterator ordinary(p_support);
+  CheckIteration(p_support, ordinary, false, count, p_name + " (ordinary)");
+  StrategyProfileIterator gray(p_support, true);
+  CheckIteration(p_support, gray, true, count, p_name + " (Gray code)");
+
+  // A frozen strategy keeps its position in the support
+  int last = p_support.NumStrategies(2);
+  StrategyProfileIterator frozen(p_support, p_support.GetStrategy(2, last));
+  Check(frozen.GetStrategyIndex(2) == last,
+	p_name + ": frozen strategy not at its position in the support");
+  CheckIteration(p_support, frozen, false, count / last,
+		 p_name + " (frozen strategy)");
+}
+
+} // end anonymous namespace
+
+int main(void)
+{
+  Array<int> dim(3);
+  dim[1] = 3;  dim[2] = 4;  dim[3] = 2;
+  Game game = NewTable(dim);
+
+  StrategySupportProfile full(game);
+  CheckSupport(full, "full support");
+
+  StrategySupportProfile restricted(game);
+  restricted.RemoveStrategy(game->GetPlayer(2)->GetStrategy(1));
+  restricted.RemoveStrategy(game->GetPlayer(1)->GetStrategy(2));
+  CheckSupport(restricted, "restricted support");
+
+  return (failures > 0) ? 1 : 0;
+}
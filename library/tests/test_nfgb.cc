@@ -0,0 +1,213 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_nfgb.cc
+// Checks of reading and writing the binary strategic game format
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/writer.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+//
+// A buffer which cannot be positioned, as when reading from a pipe
+//
+class UnpositionedBuffer : public std::stringbuf {
+public:
+  UnpositionedBuffer(const std::string &p_contents)
+    : std::stringbuf(p_contents, std::ios::in) { }
+
+protected:
+  virtual pos_type seekoff(off_type, std::ios::seekdir, std::ios::openmode)
+  { return pos_type(off_type(-1)); }
+  virtual pos_type seekpos(pos_type, std::ios::openmode)
+  { return pos_type(off_type(-1)); }
+};
+
+const char *c_dyadicGame =
+  "NFG 1 R \"Dyadic game\" { \"Row\" \"Column\" \"Third\" }\n"
+  "{ { \"U\" \"M\" \"D\" } { \"L\" \"R\" } { \"A\" \"B\" } }\n"
+  "\"A comment\"\n\n"
+  "1 -2 3/4 5/8 0 1/2 -7/4 3 1 2 2 2 1/1024 -1 0 4 4 4\n"
+  "0 0 0 1 1 1 2 2 2 3 3 3 -1/2 -1/4 -1/8 9 8 7\n";
+
+const char *c_decimalGame =
+  "NFG 1 R \"Decimal game\" { \"1\" \"2\" } { 2 2 }\n\n"
+  "0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8\n";
+
+Game ReadText(const std::string &p_text, bool p_numeric = false)
+{
+  std::istringstream stream(p_text);
+  return ReadGame(stream, p_numeric);
+}
+
+bool IsNumeric(const Game &p_game)
+{
+  GameTableRep *table = dynamic_cast<GameTableRep *>(p_game.operator->());
+  return (table && table->IsNumeric());
+}
+
+//
+// Checks that the two games have the same labels and payoffs
+//
+void CheckSame(const Game &p_game, const Game &p_copy,
+	       const std::string &p_name)
+{
+  Check(p_copy->GetTitle() == p_game->GetTitle() &&
+	p_copy->GetComment() == p_game->GetComment(),
+	p_name + ": title or comment differs");
+  Check(p_copy->NumPlayers() == p_game->NumPlayers(),
+	p_name + ": number of players differs");
+  if (p_copy->NumPlayers() != p_game->NumPlayers())  return;
+  for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    GamePlayer copy = p_copy->GetPlayer(pl);
+    Check(copy->GetLabel() == player->GetLabel(),
+	  p_name + ": player label differs");
+    Check(copy->NumStrategies() == player->NumStrategies(),
+	  p_name + ": number of strategies differs");
+    if (copy->NumStrategies() != player->NumStrategies())  return;
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      Check(copy->GetStrategy(st)->GetLabel() ==
+	    player->GetStrategy(st)->GetLabel(),
+	    p_name + ": strategy label differs");
+    }
+  }
+
+  StrategyProfileIterator iter(p_game), copyIter(p_copy);
+  for (; !iter.AtEnd() && !copyIter.AtEnd(); iter++, copyIter++) {
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      Check((*iter)->GetPayoff(pl) == (*copyIter)->GetPayoff(pl),
+	    p_name + ": payoff differs");
+    }
+  }
+}
+
+//
+// Writes the game in the binary format, checks that reading it back
+// gives the same game, and that the file is read the same when it
+// cannot be positioned.  Returns the file.
+//
+std::string CheckRoundTrip(const Game &p_game, const std::string &p_name)
+{
+  std::string file = NfgBinaryGameWriter().Write(p_game);
+  Check(file.compare(0, 8, std::string(NfgBinaryGameWriter::Magic, 8)) == 0,
+	p_name + ": file does not start with the magic");
+
+  Game copy = ReadText(file);
+  Check(IsNumeric(copy), p_name + ": game read is not a numeric table");
+  CheckSame(p_game, copy, p_name);
+  Check(NfgBinaryGameWriter().Write(copy) == file,
+	p_name + ": writing the game read gives a different file");
+
+  UnpositionedBuffer buffer(file);
+  std::istream stream(&buffer);
+  CheckSame(p_game, ReadGame(stream), p_name + " (unpositioned)");
+  return file;
+}
+
+//
+// Every shortened copy of the file must be refused as invalid, whether
+// or not the stream can be positioned
+//
+void CheckTruncated(const std::string &p_file, const std::string &p_name)
+{
+  for (size_t length = 1; length < p_file.size(); length++) {
+    for (int positioned = 0; positioned <= 1; positioned++) {
+      UnpositionedBuffer buffer(p_file.substr(0, length));
+      std::istringstream text(p_file.substr(0, length));
+      std::istream unpositioned(&buffer);
+      try {
+	ReadGame((positioned) ? (std::istream &) text : unpositioned);
+	Check(false, p_name + ": truncated file read");
+      }
+      catch (InvalidFileException &) { }
+      catch (...) {
+	Check(false, p_name + ": truncated file raised the wrong exception");
+      }
+    }
+  }
+}
+
+} // end anonymous namespace
+
+int main(void)
+{
+  // An exact game whose payoffs are all exactly doubles
+  Game dyadic = ReadText(c_dyadicGame);
+  Check(!IsNumeric(dyadic), "dyadic game read as a numeric table");
+  std::string file = CheckRoundTrip(dyadic, "dyadic game");
+  CheckTruncated(file, "dyadic game");
+
+  // The same game read as a numeric table
+  CheckRoundTrip(ReadText(c_dyadicGame, true), "numeric dyadic game");
+
+  // Decimal payoffs are not exactly doubles, but those of a numeric
+  // table are doubles already, and are kept exactly
+  Game decimal = ReadText(c_decimalGame, true);
+  Check(IsNumeric(decimal), "decimal game not read as a numeric table");
+  CheckRoundTrip(decimal, "numeric decimal game");
+
+  // An exact payoff which is not exactly a double is refused
+  Game thirds = ReadText(c_dyadicGame);
+  StrategyProfileIterator iter(thirds);
+  (*iter)->GetOutcome()->SetPayoff(2, "1/3");
+  try {
+    NfgBinaryGameWriter().Write(thirds);
+    Check(false, "payoff of 1/3 written");
+  }
+  catch (UndefinedException &) { }
+
+  // Files which are not in the format, or from a later version
+  std::string wrongMagic(file);
+  wrongMagic[1] ^= 1;
+  std::string laterVersion(file);
+  laterVersion[8] = (char) (NfgBinaryGameWriter::Version + 1);
+  std::string noPlayers(file);
+  noPlayers.replace(12, 4, std::string(4, '\0'));
+  std::string manyPlayers(file);
+  manyPlayers.replace(12, 4, std::string(4, '\xff'));
+  const std::string *invalid[] = { &wrongMagic, &laterVersion,
+				   &noPlayers, &manyPlayers };
+  for (int i = 0; i < 4; i++) {
+    try {
+      ReadText(*invalid[i]);
+      Check(false, "invalid file read");
+    }
+    catch (InvalidFileException &) { }
+  }
+
+  return (failures > 0) ? 1 : 0;
+}
@@ -0,0 +1,154 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_ranges.cc
+// Checks of iterating over ranges of contingencies
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "gambit/gambit.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+void CheckSplit(long p_count, int p_chunks)
+{
+  std::ostringstream name;
+  name << "splitting " << p_count << " into " << p_chunks;
+  Array<long> bounds = SplitContingencies(p_count, p_chunks);
+  int chunks = std::max(p_chunks, 1);
+  Check(bounds.Length() == chunks + 1, name.str() + ": wrong number of bounds");
+  Check(bounds[1] == 0 && bounds[bounds.Last()] == p_count,
+	name.str() + ": ranges do not cover the count");
+  long least = p_count, greatest = 0;
+  for (int i = 1; i < bounds.Length(); i++) {
+    least = std::min(least, bounds[i + 1] - bounds[i]);
+    greatest = std::max(greatest, bounds[i + 1] - bounds[i]);
+  }
+  Check(least >= 0 && greatest - least <= 1,
+	name.str() + ": ranges are not balanced");
+}
+
+//
+// The indices visited by the iterator, which is then at its end
+//
+std::vector<long> Visit(StrategyProfileIterator &p_iter)
+{
+  std::vector<long> indices;
+  for (; !p_iter.AtEnd(); p_iter++) {
+    Check((*p_iter)->GetIndex() == p_iter.GetIndex(),
+	  "profile index differs from iterator index");
+    indices.push_back(p_iter.GetIndex());
+  }
+  return indices;
+}
+
+//
+// Visiting the ranges from SplitContingencies() in turn, each with its
+// own iterator, must visit the same contingencies in the same order
+// as one iterator over the full range.  The iterators are made by
+// p_make, which takes an argument to choose which to make.
+//
+template <class Maker>
+void CheckRanges(Maker p_make, const std::string &p_name)
+{
+  StrategyProfileIterator *whole = p_make();
+  std::vector<long> expected = Visit(*whole);
+  long count = whole->NumContingencies();
+  delete whole;
+  Check((long) expected.size() == count,
+	p_name + ": NumContingencies() differs from the number visited");
+
+  for (int chunks = 1; chunks <= count + 2; chunks++) {
+    Array<long> bounds = SplitContingencies(count, chunks);
+    std::vector<long> visited;
+    for (int i = 1; i <= chunks; i++) {
+      StrategyProfileIterator *iter = p_make();
+      iter->SetRange(bounds[i], bounds[i + 1]);
+      Check(iter->AtEnd() || iter->GetPosition() == bounds[i],
+	    p_name + ": range does not start at its first position");
+      std::vector<long> part = Visit(*iter);
+      visited.insert(visited.end(), part.begin(), part.end());
+      delete iter;
+    }
+    std::ostringstream name;
+    name << p_name << " in " << chunks << " ranges";
+    Check(visited == expected,
+	  name.str() + ": contingencies differ from the full iteration");
+  }
+}
+
+class MakeIterator {
+private:
+  StrategySupportProfile m_support;
+  bool m_grayCode;
+  int m_frozen;
+
+public:
+  MakeIterator(const StrategySupportProfile &p_support, bool p_grayCode,
+	       int p_frozen)
+    : m_support(p_support), m_grayCode(p_grayCode), m_frozen(p_frozen) { }
+
+  StrategyProfileIterator *operator()(void) const
+  {
+    if (m_frozen > 0) {
+      return new StrategyProfileIterator(m_support, m_frozen, 2);
+    }
+    return new StrategyProfileIterator(m_support, m_grayCode);
+  }
+};
+
+} // end anonymous namespace
+
+int main(void)
+{
+  CheckSplit(0, 3);
+  CheckSplit(10, 1);
+  CheckSplit(10, 3);
+  CheckSplit(10, 4);
+  CheckSplit(3, 5);
+  CheckSplit(10, 0);
+  CheckSplit(10, -2);
+
+  Array<int> dim(3);
+  dim[1] = 3;  dim[2] = 2;  dim[3] = 4;
+  Game game = NewTable(dim);
+  StrategySupportProfile support(game);
+  support.RemoveStrategy(game->GetPlayer(3)->GetStrategy(1));
+
+  CheckRanges(MakeIterator(support, false, 0), "ordinary order");
+  CheckRanges(MakeIterator(support, true, 0), "Gray-code order");
+  CheckRanges(MakeIterator(support, false, 1), "first player frozen");
+  CheckRanges(MakeIterator(support, false, 3), "last player frozen");
+
+  return (failures > 0) ? 1 : 0;
+}
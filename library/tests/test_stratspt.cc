@@ -0,0 +1,204 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/tests/test_stratspt.cc
+// Checks of the membership and indexing of strategy supports
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "gambit/gambit.h"
+
+using namespace Gambit;
+
+namespace {
+
+int failures = 0;
+
+void Check(bool p_condition, const std::string &p_what)
+{
+  if (!p_condition) {
+    std::cerr << "FAILED: " << p_what << std::endl;
+    failures++;
+  }
+}
+
+//
+// The support as flags for each player's strategies, to compare
+// against; members[pl - 1][st - 1] is set if strategy st of player pl
+// is in the support.
+//
+typedef std::vector<std::vector<bool> > Members;
+
+//
+// Checks the support against the flags: the strategies of each player
+// in order, the index of each strategy, and the position of each
+// strategy in a mixed strategy profile on the support.
+//
+void CheckMembers(const StrategySupportProfile &p_support,
+		  const Members &p_members, const std::string &p_name)
+{
+  Game game = p_support.GetGame();
+  MixedStrategyProfile<double> profile =
+    p_support.NewMixedStrategyProfile<double>();
+  int position = 0;
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    int index = 0;
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      GameStrategy strategy = player->GetStrategy(st);
+      bool member = p_members[pl - 1][st - 1];
+      Check(p_support.Contains(strategy) == member,
+	    p_name + ": membership differs");
+      if (member) {
+	index++;
+	position++;
+	Check(p_support.GetIndex(strategy) == index,
+	      p_name + ": index in support differs");
+	Check(index <= p_support.NumStrategies(pl) &&
+	      p_support.GetStrategy(pl, index) == strategy,
+	      p_name + ": strategy at index differs");
+	profile[strategy] = position;
+      }
+      else {
+	Check(p_support.GetIndex(strategy) == 0,
+	      p_name + ": index of strategy not in support");
+      }
+    }
+    Check(p_support.NumStrategies(pl) == index,
+	  p_name + ": number of strategies differs");
+  }
+  Check(p_support.MixedProfileLength() == position,
+	p_name + ": length of mixed profile differs");
+  for (int i = 1; i <= position && i <= profile.MixedProfileLength(); i++) {
+    Check(profile[i] == i, p_name + ": position in mixed profile differs");
+  }
+}
+
+//
+// Builds the support with the flagged strategies by removing the others
+// from the full support, last strategy first.
+//
+StrategySupportProfile Build(const Game &p_game, const Members &p_members)
+{
+  StrategySupportProfile support(p_game);
+  for (int pl = p_game->NumPlayers(); pl >= 1; pl--) {
+    GamePlayer player = p_game->GetPlayer(pl);
+    for (int st = player->NumStrategies(); st >= 1; st--) {
+      if (!p_members[pl - 1][st - 1]) {
+	support.RemoveStrategy(player->GetStrategy(st));
+      }
+    }
+  }
+  return support;
+}
+
+void CheckOrder(const StrategySupportProfile &p_first,
+		const StrategySupportProfile &p_second,
+		const std::string &p_name)
+{
+  if (p_first == p_second) {
+    Check(p_first.Hash() == p_second.Hash(),
+	  p_name + ": equal supports hash differently");
+    Check(!(p_first < p_second) && !(p_second < p_first),
+	  p_name + ": equal supports are ordered");
+    Check(p_first.IsSubsetOf(p_second) && p_second.IsSubsetOf(p_first),
+	  p_name + ": equal supports are not subsets of each other");
+  }
+  else {
+    Check((p_first < p_second) != (p_second < p_first),
+	  p_name + ": unequal supports are not ordered one way");
+    Check(!p_first.IsSubsetOf(p_second) || !p_second.IsSubsetOf(p_first),
+	  p_name + ": unequal supports are subsets of each other");
+  }
+}
+
+} // end anonymous namespace
+
+int main(void)
+{
+  // More strategies than fit in one word of the bitset, with the
+  // players' strategies straddling the word boundaries
+  Array<int> dim(3);
+  dim[1] = 30;  dim[2] = 50;  dim[3] = 61;
+  Game game = NewTable(dim);
+
+  Members members(game->NumPlayers());
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    members[pl - 1].assign(dim[pl], true);
+  }
+  StrategySupportProfile support(game);
+  CheckMembers(support, members, "full support");
+
+  // A fixed sequence of pseudo-random removals and additions
+  unsigned long seed = 12345UL;
+  for (int step = 1; step <= 400; step++) {
+    seed = seed * 1103515245UL + 12345UL;
+    int pl = (seed >> 8) % game->NumPlayers() + 1;
+    int st = (seed >> 16) % dim[pl] + 1;
+    bool add = ((seed >> 24) % 3 == 0);
+    GameStrategy strategy = game->GetPlayer(pl)->GetStrategy(st);
+
+    std::ostringstream name;
+    name << "step " << step << " (" << ((add) ? "adding" : "removing")
+	 << " strategy " << st << " of player " << pl << ")";
+
+    StrategySupportProfile before(support);
+    if (add) {
+      support.AddStrategy(strategy);
+      members[pl - 1][st - 1] = true;
+      Check(before.IsSubsetOf(support),
+	    name.str() + ": support is not a superset after adding");
+    }
+    else {
+      int count = 0;
+      for (int i = 0; i < dim[pl]; i++) {
+	count += members[pl - 1][i];
+      }
+      bool removed = support.RemoveStrategy(strategy);
+      Check(removed == (members[pl - 1][st - 1] && count > 1),
+	    name.str() + ": removal reported wrongly");
+      if (removed) {
+	members[pl - 1][st - 1] = false;
+      }
+      Check(support.IsSubsetOf(before),
+	    name.str() + ": support is not a subset after removing");
+    }
+    CheckMembers(support, members, name.str());
+    CheckOrder(before, support, name.str() + " against before");
+    StrategySupportProfile rebuilt = Build(game, members);
+    Check(rebuilt == support,
+	  name.str() + ": support differs when built in another order");
+    CheckOrder(rebuilt, support, name.str() + " against rebuilt");
+  }
+
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    for (int st = 1; st <= dim[pl]; st++) {
+      support.AddStrategy(game->GetPlayer(pl)->GetStrategy(st));
+      members[pl - 1][st - 1] = true;
+    }
+  }
+  CheckMembers(support, members, "support after adding back");
+  StrategySupportProfile full(game);
+  Check(support == full, "support is not full after adding back");
+  Check(support.Hash() == full.Hash(), "full supports hash differently");
+
+  return (failures > 0) ? 1 : 0;
+}
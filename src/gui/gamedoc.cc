@@ -116,7 +116,7 @@ bool gbtBehavDominanceStack::PreviousLevel(void)
 
 gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 						     bool p_strict)
-  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false)
+  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false), m_elimination(0)
 {
   Reset();
 }
@@ -124,12 +124,15 @@ gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 gbtStrategyDominanceStack::~gbtStrategyDominanceStack()
 {
   for (int i = 1; i <= m_supports.Length(); delete m_supports[i++]);
+  delete m_elimination;
 }
 
 void gbtStrategyDominanceStack::SetStrict(bool p_strict)
 {
-  if (m_strict != p_strict)  Reset();
-  m_strict = p_strict;
+  if (m_strict != p_strict) {
+    m_strict = p_strict;
+    Reset();
+  }
 }
 
 void gbtStrategyDominanceStack::Reset(void)
@@ -139,6 +142,8 @@ void gbtStrategyDominanceStack::Reset(void)
   m_supports.Append(new Gambit::StrategySupportProfile(m_doc->GetGame()));
   m_current = 1;
   m_noFurther = false;
+  delete m_elimination;
+  m_elimination = new Gambit::IteratedDominance(*m_supports[1], m_strict);
 }
 
 bool gbtStrategyDominanceStack::NextLevel(void)
@@ -152,16 +157,10 @@ bool gbtStrategyDominanceStack::NextLevel(void)
     return false;
   }
 
-  Gambit::Array<int> players;
-  for (int pl = 1; pl <= m_doc->GetGame()->NumPlayers(); pl++) {
-    players.Append(pl);
-  }
-
-  Gambit::StrategySupportProfile newSupport = 
-    m_supports[m_current]->Undominated(m_strict, players);
-
-  if (newSupport != *m_supports[m_current]) {
-    m_supports.Append(new Gambit::StrategySupportProfile(newSupport));
+  // The elimination is always at the last level on the stack, so it
+  // only needs to be taken one level further
+  if (m_elimination->NextLevel()) {
+    m_supports.Append(new Gambit::StrategySupportProfile(m_elimination->GetSupport()));
     m_current++;
     return true;
   }
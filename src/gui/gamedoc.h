@@ -117,6 +117,8 @@ private:
   Gambit::Array<Gambit::StrategySupportProfile *> m_supports;
   int m_current;
   bool m_noFurther;
+  /// The elimination from which the next level is taken
+  Gambit::IteratedDominance *m_elimination;
 
 public:
   gbtStrategyDominanceStack(gbtGameDocument *p_doc, bool p_strict);
@@ -65,9 +65,12 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
-  std::cerr << "  -D               don't eliminate dominated strategies first\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -L               use lrslib for enumeration (experimental!)\n";
   std::cerr << "  -c               output connectedness information\n";
+  std::cerr << "  -t, --threads=N  match vertices using N threads (default is 1;\n";
+  std::cerr << "                   only available if built with thread support)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -77,17 +80,18 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   int c;
-  bool useFloat = false, uselrs = false, quiet = false, eliminate = true;
+  bool useFloat = false, uselrs = false, quiet = false, eliminate = false;
   bool showConnect = false;
-  int numDecimals = 6;
+  int numDecimals = 6, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "threads", 1, NULL, 't'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqcSL", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DEvhqcSLt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -98,6 +102,9 @@ int main(int argc, char *argv[])
     case 'D':
       eliminate = false;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'L':
       uselrs = true;
       break;
@@ -107,6 +114,9 @@ int main(int argc, char *argv[])
     case 'c':
       showConnect = true;
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
     case 'S':
       break;
     case 'q':
@@ -144,9 +154,15 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game, numThreads);
+    }
     if (uselrs) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (eliminate) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
       EnumMixedLrsStrategySolver solver(renderer);
       solver.Solve(game);
     }
@@ -154,7 +170,10 @@ int main(int argc, char *argv[])
       shared_ptr<StrategyProfileRenderer<double> > renderer;
       renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						      numDecimals);
-      EnumMixedStrategySolver<double> solver(renderer);
+      if (eliminate) {
+	renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+      }
+      EnumMixedStrategySolver<double> solver(renderer, numThreads);
       shared_ptr<EnumMixedStrategySolution<double> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
@@ -166,7 +185,10 @@ int main(int argc, char *argv[])
     else {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      EnumMixedStrategySolver<Rational> solver(renderer);
+      if (eliminate) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
+      EnumMixedStrategySolver<Rational> solver(renderer, numThreads);
       shared_ptr<EnumMixedStrategySolution<Rational> > solution =
 	solver.SolveDetailed(game);
       if (showConnect) {
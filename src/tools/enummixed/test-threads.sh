@@ -0,0 +1,42 @@
+#!/bin/sh
+##
+## This file is part of Gambit
+## Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+##
+## FILE: src/tools/enummixed/test-threads.sh
+## Checks that gambit-enummixed finds the same equilibria in threads
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 2 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with this program; if not, write to the Free Software
+## Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+##
+
+# The threads may match the vertices in another order, so the
+# equilibria are compared sorted, both in exact arithmetic and in
+# floating point.  A run in threads which fails, as when run under a
+# thread sanitizer which finds a race, fails the check.
+
+: ${srcdir=.}
+status=0
+for game in $srcdir/contrib/games/*.nfg; do
+  for flags in "" "-d 10"; do
+    serial=$(./gambit-enummixed -q $flags $game 2>&1) || continue
+    threaded=$(./gambit-enummixed -q $flags -t 3 $game 2>&1)
+    if test $? -ne 0 ||
+       test "$(echo "$serial" | sort)" != "$(echo "$threaded" | sort)"; then
+      echo "FAILED: gambit-enummixed $flags -t 3 $game"
+      status=1
+    fi
+  done
+done
+exit $status
@@ -27,6 +27,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "gambit/gambit.h"
+#include "gambit/nash.h"
 #include "nfghs.h"
 
 int g_numDecimals = 6;
@@ -51,6 +52,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      show equilibrium probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first (implies -S)\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
@@ -68,7 +71,7 @@ int main(int argc, char *argv[])
   opterr = 0;
 
   bool quiet = false;
-  bool useHeuristic = false, useStrategic = false;
+  bool useHeuristic = false, useStrategic = false, eliminate = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -78,7 +81,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHSEqvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -94,6 +97,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -136,6 +142,11 @@ int main(int argc, char *argv[])
       throw Gambit::UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
 
+    if (eliminate) {
+      game = Gambit::Nash::EliminateDominatedStrategies(game);
+      useStrategic = true;
+    }
+
     if (!game->IsTree() || useStrategic) {
       if (useHeuristic) {
 	gbtNfgHs algorithm(0);
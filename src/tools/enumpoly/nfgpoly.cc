@@ -427,6 +427,13 @@ void PrintProfile(std::ostream &p_stream,
 		  const std::string &p_label,
 		  const Gambit::MixedStrategyProfile<double> &p_profile)
 {
+  if (p_profile.GetGame()->IsRestriction()) {
+    // Profiles on a game with dominated strategies eliminated are
+    // reported on the original game
+    PrintProfile(p_stream, p_label, p_profile.Unrestrict());
+    return;
+  }
+
   p_stream << p_label;
   for (int i = 1; i <= p_profile.MixedProfileLength(); i++) {
     p_stream.setf(std::ios::fixed);
@@ -49,8 +49,14 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -S               report equilibria in strategies even for extensive games\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first (implies -S)\n";
   std::cerr << "  -A               compute agent form equilibria\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
+  std::cerr << "                   (default is to find all)\n";
+  std::cerr << "  -t, --threads=N  search using N threads (default is 1; only\n";
+  std::cerr << "                   available if built with thread support)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -62,16 +68,18 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
-  bool printDetail = false;
+  bool printDetail = false, eliminate = false;
+  int stopAfter = 0, numThreads = 1;
   
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "threads", 1, NULL, 't'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPEe:t:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -87,6 +95,15 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
+    case 'e':
+      stopAfter = atoi(optarg);
+      break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -125,6 +142,10 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game, numThreads);
+      reportStrategic = true;
+    }
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
       if (printDetail) {
@@ -133,6 +154,9 @@ int main(int argc, char *argv[])
       else {
 	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
       }
+      if (eliminate) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
     }
     else {
       if (printDetail) {
@@ -151,7 +175,7 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<StrategySolver<Rational> > substage = 
-	    new EnumPureStrategySolver();
+	    new EnumPureStrategySolver(0, 0, numThreads);
 	  stage = new BehavViaStrategySolver<Rational>(substage);
 	}
 	SubgameBehavSolver<Rational> algorithm(stage, renderer);
@@ -163,13 +187,13 @@ int main(int argc, char *argv[])
 	  algorithm.Solve(game);
 	}
 	else {
-	  EnumPureStrategySolver algorithm(renderer);
+	  EnumPureStrategySolver algorithm(renderer, stopAfter, numThreads);
 	  algorithm.Solve(game);
 	}
       }
     }
     else {
-      EnumPureStrategySolver algorithm(renderer);
+      EnumPureStrategySolver algorithm(renderer, stopAfter, numThreads);
       algorithm.Solve(game);
     }
     return 0;
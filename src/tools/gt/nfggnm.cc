@@ -84,6 +84,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
@@ -97,7 +99,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  bool quiet = false, verbose = false;
+  bool quiet = false, verbose = false, eliminate = false;
   int numDecimals = 6, numVectors = 1;
   std::string startFile;
 
@@ -109,7 +111,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:qvVhSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -128,6 +130,9 @@ int main(int argc, char *argv[])
     case 's':
       startFile = optarg;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'S':
       break;
     case 'h':
@@ -146,6 +151,11 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (eliminate && startFile != "") {
+    std::cerr << argv[0] << ": -E cannot be used with -s\n";
+    return 1;
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -165,9 +175,15 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game);
+    }
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
+    if (eliminate) {
+      renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+    }
     NashGNMStrategySolver solver(renderer, verbose);
 
     List<MixedStrategyProfile<double> > perts;
@@ -49,6 +49,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
@@ -60,7 +62,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  bool quiet = false, verbose = false;
+  bool quiet = false, verbose = false, eliminate = false;
   int numDecimals = 6;
 
   int long_opt_index = 0;
@@ -71,7 +73,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:vVqhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:vVqhSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -84,6 +86,9 @@ int main(int argc, char *argv[])
     case 'd':
       numDecimals = atoi(optarg);
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'S':
       break;
     case 'h':
@@ -121,9 +126,15 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game);
+    }
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
+    if (eliminate) {
+      renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+    }
     NashIPAStrategySolver solver(renderer);
     solver.Solve(game);
     return 0;
@@ -49,34 +49,64 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      compute using floating-point arithmetic;\n";
   std::cerr << "                   display results with DECIMALS digits\n";
+  std::cerr << "  -c, --certify    follow paths in floating point, and certify the\n";
+  std::cerr << "                   equilibria found exactly (implies -S; not with -d)\n";
   std::cerr << "  -S               use strategic game\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first (implies -S)\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
   std::cerr << "                   (only if number of equilibria sought is not 1)\n";
+  std::cerr << "  -t, --threads=N  follow paths using N threads (default is 1;\n";
+  std::cerr << "                   only available if built with thread support)\n";
+  std::cerr << "  -R, --race       find one equilibrium by following the paths for\n";
+  std::cerr << "                   the labels at once, one in each of the N threads\n";
+  std::cerr << "                   (implies -S and -e 1; only available if built\n";
+  std::cerr << "                   with thread support)\n";
   std::cerr << "  -D               print detailed information about equilibria\n";
+  std::cerr << "                   (and, with -e 1, pivots along each path)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
 }
 
+//
+// Reports the number of pivots made along the path for each label,
+// marking the path which gave the equilibrium
+//
+template <class T>
+void PrintPivotCounts(const NashLcpStrategySolver<T> &p_solver)
+{
+  const Array<long> &counts = p_solver.GetPivotCounts();
+  for (int i = counts.First(); i <= counts.Last(); i++) {
+    std::cerr << "Label " << i << ": " << counts[i] << " pivots";
+    if (i == p_solver.GetRaceWinner()) {
+      std::cerr << " (equilibrium)";
+    }
+    std::cerr << std::endl;
+  }
+}
 
 int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
-  int numDecimals = 6, stopAfter = 0, maxDepth = 0;
+  bool printDetail = false, eliminate = false, race = false, certify = false;
+  int numDecimals = 6, stopAfter = 0, maxDepth = 0, numThreads = 1;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "threads", 1, NULL, 't'  },
+    { "race", 0, NULL, 'R'  },
+    { "certify", 0, NULL, 'c'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPEe:r:t:Rc", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -99,12 +129,24 @@ int main(int argc, char *argv[])
     case 'r':
       maxDepth = atoi(optarg);
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      break;
     case 'S':
       useStrategic = true;
       break;
     case 'P':
       bySubgames = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
+    case 'R':
+      race = true;
+      break;
+    case 'c':
+      certify = true;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -118,6 +160,14 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (race) {
+    useStrategic = true;
+    stopAfter = 1;
+  }
+  if (certify) {
+    useStrategic = true;
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -137,6 +187,10 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game, numThreads);
+      useStrategic = true;
+    }
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -147,9 +201,15 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<double>(std::cout, numDecimals);
 	}
+	if (eliminate) {
+	  renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLcpStrategySolver<double> algorithm(stopAfter, maxDepth,
-						renderer);
+						renderer, numThreads, race);
 	algorithm.Solve(game);
+	if (printDetail && stopAfter == 1) {
+	  PrintPivotCounts(algorithm);
+	}
       }
       else {
 	shared_ptr<StrategyProfileRenderer<Rational> > renderer;
@@ -159,9 +219,16 @@ int main(int argc, char *argv[])
 	else {
 	  renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
 	}
+	if (eliminate) {
+	  renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+	}
 	NashLcpStrategySolver<Rational> algorithm(stopAfter, maxDepth,
-						  renderer);
+						  renderer, numThreads, race,
+						  certify);
 	algorithm.Solve(game);
+	if (printDetail && stopAfter == 1) {
+	  PrintPivotCounts(algorithm);
+	}
       }
     }
     else {
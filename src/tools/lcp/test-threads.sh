@@ -0,0 +1,56 @@
+#!/bin/sh
+##
+## This file is part of Gambit
+## Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+##
+## FILE: src/tools/lcp/test-threads.sh
+## Checks that gambit-lcp finds the same equilibria in threads
+##
+## This program is free software; you can redistribute it and/or modify
+## it under the terms of the GNU General Public License as published by
+## the Free Software Foundation; either version 2 of the License, or
+## (at your option) any later version.
+##
+## This program is distributed in the hope that it will be useful,
+## but WITHOUT ANY WARRANTY; without even the implied warranty of
+## MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+## GNU General Public License for more details.
+##
+## You should have received a copy of the GNU General Public License
+## along with this program; if not, write to the Free Software
+## Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+##
+
+# The paths are followed in exact arithmetic, or in floating point and
+# certified exactly with -c, and the equilibria are compared sorted, as
+# the threads may report them in another order.  The one equilibrium
+# found by racing the paths with -R must be among them.  A run in
+# threads which fails, as when run under a thread sanitizer which finds
+# a race, fails the check.
+
+: ${srcdir=.}
+status=0
+for game in $srcdir/contrib/games/*.nfg; do
+  serial=$(./gambit-lcp -q $game 2>&1) || continue
+  expected=$(echo "$serial" | sort)
+  for flags in "" "-c"; do
+    threaded=$(./gambit-lcp -q $flags -t 3 $game 2>&1)
+    if test $? -ne 0 || test "$(echo "$threaded" | sort)" != "$expected"; then
+      echo "FAILED: gambit-lcp $flags -t 3 $game"
+      status=1
+    fi
+  done
+  serial=$(./gambit-lcp -q -E $game 2>&1)
+  threaded=$(./gambit-lcp -q -E -t 3 $game 2>&1)
+  if test $? -ne 0 ||
+     test "$(echo "$threaded" | sort)" != "$(echo "$serial" | sort)"; then
+    echo "FAILED: gambit-lcp -E -t 3 $game"
+    status=1
+  fi
+  raced=$(./gambit-lcp -q -R -t 3 $game 2>&1)
+  if test $? -ne 0 || ! echo "$expected" | grep -qxF "$raced"; then
+    echo "FAILED: gambit-lcp -R -t 3 $game"
+    status=1
+  fi
+done
+exit $status
@@ -48,6 +48,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first (uses strategic game)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
   std::cerr << "  -s FILE          file containing starting points\n";
@@ -134,6 +136,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
+  bool eliminate = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
@@ -148,7 +151,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:hqVvSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -167,6 +170,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -186,6 +192,11 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (eliminate && startFile != "") {
+    std::cerr << argv[0] << ": -E cannot be used with -s\n";
+    return 1;
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -205,6 +216,10 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game);
+      useStrategic = true;
+    }
     if (!game->IsTree() || useStrategic) {
       List<MixedStrategyProfile<double> > starts;
       if (startFile != "") {
@@ -220,6 +235,9 @@ int main(int argc, char *argv[])
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
 	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 							numDecimals);
+	if (eliminate) {
+	  renderer = new UnrestrictedStrategyRenderer<double>(renderer);
+	}
 	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
 	algorithm.Solve(starts[i]);
       }
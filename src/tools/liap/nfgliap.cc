@@ -38,13 +38,23 @@ using namespace Gambit;
 class StrategicLyapunovFunction : public FunctionOnSimplices {
 public:
   StrategicLyapunovFunction(const MixedStrategyProfile<double> &p_start)
-    : m_game(p_start.GetGame()), m_profile(p_start)
+    : m_game(p_start.GetGame()), m_profile(p_start),
+      m_values(p_start.MixedProfileLength()),
+      m_derivs(p_start.MixedProfileLength(), p_start.MixedProfileLength()),
+      m_payoffs(m_game->NumPlayers()),
+      m_payoffDerivs(m_game->NumPlayers(), p_start.MixedProfileLength())
   { }
   virtual ~StrategicLyapunovFunction() { }
 
 private:
   Game m_game;
   mutable MixedStrategyProfile<double> m_profile;
+  /// Payoffs to each strategy, and their derivatives, at m_profile
+  mutable Vector<double> m_values;
+  mutable Matrix<double> m_derivs;
+  /// Payoffs to each player, and their derivatives, at m_profile
+  mutable Vector<double> m_payoffs;
+  mutable Matrix<double> m_payoffDerivs;
 
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
@@ -52,26 +62,33 @@ private:
   double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
 };
 
+//
+// This relies on the payoffs and their derivatives at the profile having
+// been computed already by Gradient().
+//
 double 
 StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
 					  const MixedStrategyProfile<double> &p) const
 {
   GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
+  int wrt_index = j1;
+  for (int i = 1; i < i1; i++) {
+    wrt_index += m_game->Players()[i]->NumStrategies();
+  }
   double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
+  for (int i = 1, index = 1; i <= m_game->NumPlayers(); i++)  {
     double psum = 0.0;
     GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
+    for (int j = 1; j <= player->NumStrategies(); j++, index++)  {
       GameStrategy strategy = player->Strategies()[j];
       psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
+      double x1 = m_values[index] - m_payoffs[i];
       if (i1 == i) {
 	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+	  x -= x1 * m_values[wrt_index];
       }
       else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+	x += x1 * (m_derivs(index, wrt_index) - m_payoffDerivs(i, wrt_index));
       }
     }
     if (i == i1)  {
@@ -88,8 +105,27 @@ bool
 StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
   static_cast<Vector<double> &>(m_profile).operator=(v);
+  m_profile.GetStrategyValues(m_values);
+  m_profile.GetStrategyValueDerivs(m_derivs);
+  // The derivative of a player's payoff with respect to the probability
+  // of another player's strategy is the expectation, under the first
+  // player's mixed strategy, of the corresponding derivatives of the
+  // payoffs to the first player's strategies.
+  // As in GetPayoffDeriv(), strategies with negative probability
+  // are not included.
+  m_payoffDerivs = 0.0;
+  for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
+    m_payoffs[pl] = m_profile.GetPayoff(pl);
+    for (int st = 1; st <= m_game->Players()[pl]->NumStrategies(); st++, ii++) {
+      if (m_profile[ii] <= 0.0) continue;
+      for (int jj = 1; jj <= m_derivs.NumColumns(); jj++) {
+	m_payoffDerivs(pl, jj) += m_profile[ii] * m_derivs(ii, jj);
+      }
+    }
+  }
+
   for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
-    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
+    for (int st = 1; st <= m_game->Players()[pl]->NumStrategies(); st++) {
       d[ii++] = LiapDerivValue(pl, st, m_profile);
     }
   }
@@ -59,6 +59,8 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> values(profile.MixedProfileLength());
+  profile.GetStrategyValues(values);
   p_lhs = 0.0;
   for (int rowno = 0, pl = 1; pl <= m_game->NumPlayers(); pl++) {
     GamePlayer player = m_game->Players()[pl];
@@ -75,8 +77,7 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 	// This is a ratio equation
 	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
 			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
+			lambda * (values[rowno] - values[rowno - st + 1]));
 
       }
     }
@@ -93,6 +94,11 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
     logprofile[i] = p_point[i];
   }
   double lambda = p_point[p_point.Length()];
+  Vector<double> values(profile.MixedProfileLength());
+  profile.GetStrategyValues(values);
+  Matrix<double> derivs(profile.MixedProfileLength(),
+			profile.MixedProfileLength());
+  profile.GetStrategyValueDerivs(derivs);
 
   p_matrix = 0.0;
 
@@ -132,19 +138,13 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
 	    else {
 	      p_matrix(colno, rowno) =
 		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		(derivs(rowno, colno) - derivs(rowno - j + 1, colno));
 	    }
 	  }
 	}
 	// Fill the last column, the derivative wrt lambda
 	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
+	  (values[rowno - j + 1] - values[rowno]);
       }
     }
   }
@@ -88,6 +88,8 @@ void PrintHelp(char *progname)
 
   std::cerr << "Options:\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
+  std::cerr << "  -E               eliminate strategies dominated by pure or mixed\n";
+  std::cerr << "                   strategies first\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
   std::cerr << "  -n COUNT         number of starting points to generate (requires -r)\n";
@@ -105,7 +107,7 @@ int main(int argc, char *argv[])
   std::string startFile;
   bool useRandom = false;
   int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  bool verbose = false, quiet = false, eliminate = false;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -115,7 +117,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qSE", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -141,6 +143,9 @@ int main(int argc, char *argv[])
     case 'V':
       verbose = true;
       break;
+    case 'E':
+      eliminate = true;
+      break;
     case 'S':
       break;
     case '?':
@@ -156,6 +161,11 @@ int main(int argc, char *argv[])
     }
   }
 
+  if (eliminate && startFile != "") {
+    std::cerr << argv[0] << ": -E cannot be used with -s\n";
+    return 1;
+  }
+
   if (!quiet) {
     PrintBanner(std::cerr);
   }
@@ -175,6 +185,9 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
+    if (eliminate) {
+      game = EliminateDominatedStrategies(game);
+    }
     List<MixedStrategyProfile<Rational> > starts;
     if (startFile != "") {
       std::ifstream startPoints(startFile.c_str());
@@ -193,6 +206,9 @@ int main(int argc, char *argv[])
     for (int i = 1; i <= starts.size(); i++) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
       renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      if (eliminate) {
+	renderer = new UnrestrictedStrategyRenderer<Rational>(renderer);
+      }
       NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
 					  renderer);
       algorithm.Solve(starts[i]);